@@ -30,12 +30,16 @@ SOFTWARE.
 
 #ifdef TVOUT_SCREENS
 #include "screens.h" // function headers
+#include "widgets.h"
+#include "hardware.h"
 #include <Arduino.h>
 
 
 #include <TVout.h>
 #include <fontALL.h>
 
+typedef screens_t<DISPLAY_TVOUT> tvScreens;
+
 // Set you TV format (PAL = Europe = 50Hz, NTSC = INT = 60Hz)
 //#define TV_FORMAT NTSC
 #define TV_FORMAT PAL
@@ -57,16 +61,66 @@ SOFTWARE.
 #endif
 #define TV_Y_GRID 14
 #define TV_Y_OFFSET 3
+#define RSSI_BAR_SIZE 100
+#define SCANNER_BAR_MINI_SIZE 14
 
 
 TVout TV;
 
-screens::screens() {
+// TVout does not tell which font is in use, the widgets need its size.
+static const unsigned char *tv_font;
+
+static void selectFont(const unsigned char *font) {
+    tv_font = font;
+    TV.select_font(font);
+}
+
+// numbers without the divisions of TVout::printNumber()
+static void printNumber(uint8_t x, uint8_t y, uint16_t number, uint8_t style = 0) {
+    char text[NUM_SIZE];
+    numFormat(text, number, style);
+    TV.print(x, y, text);
+}
+
+template<> void widgetHooks<DISPLAY_TVOUT>::fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    if(!w) {
+        return;
+    }
+    for(uint8_t i = 0; i < h; i++) {
+        TV.draw_row(y+i, x, x+w-1, color);
+    }
+}
+
+template<> void widgetHooks<DISPLAY_TVOUT>::drawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    if(w && h) {
+        TV.draw_rect(x, y, w-1, h-1, color);
+    }
+}
+
+template<> void widgetHooks<DISPLAY_TVOUT>::text(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const char *text, uint8_t style) {
+    uint8_t font_width = pgm_read_byte(tv_font);
+    uint8_t font_height = pgm_read_byte(tv_font+1);
+    widgetFillRect(x, y, w, h, BLACK);
+    uint8_t text_x = x;
+    if((style & WIDGET_CENTER) && strlen(text)*font_width < w) {
+        text_x += (w - strlen(text)*font_width) / 2;
+    }
+    TV.print(text_x, y + (h - font_height + 1) / 2, text);
+    if(style & WIDGET_INVERT) {
+        widgetFillRect(x, y, w, h, INVERT);
+    }
+}
+
+template<> void widgetHooks<DISPLAY_TVOUT>::invalidate(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    // TVout draws straight into the buffer that is on screen.
+}
+
+template<> tvScreens::screens_t() {
     last_channel = -1;
     last_rssi = 0;
 }
 
-char screens::begin(const char *call_sign) {
+template<> char tvScreens::begin(const char *call_sign) {
     // 0 if no error.
     // 1 if x is not divisable by 8.
     // 2 if y is to large (NTSC only cannot fill PAL vertical resolution by 8bit limit)
@@ -74,27 +128,28 @@ char screens::begin(const char *call_sign) {
     return TV.begin(TV_FORMAT, TV_COLS, TV_ROWS);
 }
 
-void screens::reset() {
+template<> void tvScreens::reset() {
+    widgetsReset();
     TV.clear_screen();
-    TV.select_font(font8x8);
+    selectFont(font8x8);
 }
 
-void screens::flip() {
+template<> void tvScreens::flip() {
 }
 
-void screens::drawTitleBox(const char *title) {
+template<> void tvScreens::drawTitleBox(const char *title) {
     TV.draw_rect(0,0,127,95,  WHITE);
     TV.printPGM(((127-strlen_P(title)*8)/2), 3,  title);
     TV.draw_rect(0,0,127,14,  WHITE,INVERT);
 }
-void screens::drawBottomTriangle(bool color){
+template<> void tvScreens::drawBottomTriangle(bool color){
     //isn't needed NOW for tvscreen
 }
-void screens::drawTopTriangle(bool color){
+template<> void tvScreens::drawTopTriangle(bool color){
     //isn't needed NOW for tvscreen
 }
 
-void screens::mainMenu(uint8_t menu_id) {
+template<> void tvScreens::mainMenu(uint8_t menu_id) {
     reset(); // start from fresh screen.
     drawTitleBox(PSTR("MODE SELECTION"));
 
@@ -113,7 +168,7 @@ void screens::mainMenu(uint8_t menu_id) {
     TV.draw_rect(0,3+(menu_id+1)*MENU_Y_SIZE,127,12,  WHITE, INVERT);
 }
 
-void screens::seekMode(uint8_t state) {
+template<> void tvScreens::seekMode(uint8_t state) {
     last_channel = -1;
     reset(); // start from fresh screen.
     if (state == STATE_MANUAL)
@@ -127,11 +182,10 @@ void screens::seekMode(uint8_t state) {
     TV.draw_line(0,1*TV_Y_GRID,TV_X_MAX,1*TV_Y_GRID,WHITE);
     TV.printPGM(5,TV_Y_OFFSET+1*TV_Y_GRID,  PSTR("BAND: "));
     TV.draw_line(0,2*TV_Y_GRID,TV_X_MAX,2*TV_Y_GRID,WHITE);
-    TV.printPGM(5 ,TV_Y_OFFSET-1+2*TV_Y_GRID,  PSTR("1 2 3 4 5 6 7 8"));
     TV.draw_line(0,3*TV_Y_GRID,TV_X_MAX,3*TV_Y_GRID,WHITE);
     TV.printPGM(5,TV_Y_OFFSET+3*TV_Y_GRID,  PSTR("FREQ:     GHz"));
     TV.draw_line(0,4*TV_Y_GRID,TV_X_MAX,4*TV_Y_GRID,WHITE);
-    TV.select_font(font4x6);
+    selectFont(font4x6);
     TV.printPGM(5,TV_Y_OFFSET+4*TV_Y_GRID,  PSTR("RSSI:"));
     TV.draw_line(0,5*TV_Y_GRID-4,TV_X_MAX,5*TV_Y_GRID-4,WHITE);
     // frame for tune graph
@@ -144,116 +198,113 @@ void screens::seekMode(uint8_t state) {
     TV.print(57, (TV_ROWS - TV_SCANNER_OFFSET + 2), "5800");
     TV.print(111, (TV_ROWS - TV_SCANNER_OFFSET + 2), "5945");
 
+    widgets[WIDGET_SEEK_TITLE].label(0, 0, TV_COLS, TV_Y_GRID, WIDGET_CENTER);
+    widgets[WIDGET_SEEK_BAND].label(50, TV_Y_OFFSET+1*TV_Y_GRID, 9*8, 8, 0);
+    widgets[WIDGET_SEEK_CHANNELS].list(2, TV_Y_OFFSET-2+2*TV_Y_GRID, 13, 12, 16, channelItems, CHANNEL_BAND_SIZE, WIDGET_CENTER);
+    widgets[WIDGET_SEEK_FREQUENCY].number(50, TV_Y_OFFSET+3*TV_Y_GRID, 4*8, 8, 0);
+    widgets[WIDGET_SEEK_RSSI].bar(25, TV_Y_OFFSET+4*TV_Y_GRID, RSSI_BAR_SIZE+1, 5, 0);
+    widgets[WIDGET_SEEK_THRESHOLD_LEFT].marker(1, TV_ROWS - TV_SCANNER_OFFSET - SCANNER_BAR_MINI_SIZE, 3, 1, WIDGET_VERTICAL);
+    widgets[WIDGET_SEEK_THRESHOLD_RIGHT].marker(TV_X_MAX-2, TV_ROWS - TV_SCANNER_OFFSET - SCANNER_BAR_MINI_SIZE, 2, 1, WIDGET_VERTICAL);
+    widgets[WIDGET_SEEK_MARKER].marker(5, TV_ROWS - TV_SCANNER_OFFSET + 8, SCANNER_MARKER_SIZE+1, SCANNER_MARKER_SIZE+1, 0);
 }
 
-void screens::updateSeekMode(uint8_t state, uint8_t channelIndex, uint8_t channel, uint8_t rssi, uint16_t channelFrequency, uint8_t rssi_seek_threshold, bool locked) {
+template<> void tvScreens::updateSeekMode(uint8_t state, uint8_t channelIndex, uint8_t channel, uint8_t rssi, uint16_t channelFrequency, uint8_t rssi_seek_threshold, bool locked) {
     // display refresh handler
-    TV.select_font(font8x8);
-    if(channelIndex != last_channel) // only updated on changes
+    selectFont(font8x8);
+    // show current used channel of bank
+    const char *band;
+#ifdef USE_LBAND
+    if(channelIndex > 39)
     {
-        // show current used channel of bank
+        band = PSTR("D/5.3");
+    }
+    else if(channelIndex > 31)
+#else
+    if(channelIndex > 31)
+#endif
+    {
+        band = PSTR("C/Race");
+    }
+    else if(channelIndex > 23)
+    {
+        band = PSTR("F/Airwave");
+    }
+    else if (channelIndex > 15)
+    {
+        band = PSTR("E");
+    }
+    else if (channelIndex > 7)
+    {
+        band = PSTR("B");
+    }
+    else
+    {
+        band = PSTR("A");
+    }
+    widgets[WIDGET_SEEK_BAND].update(band);
+    // show channel inside band
+    widgets[WIDGET_SEEK_CHANNELS].update(channelIndex%CHANNEL_BAND_SIZE);
 #ifdef USE_LBAND
-        if(channelIndex > 39)
-        {
-            TV.printPGM(50,TV_Y_OFFSET+1*TV_Y_GRID,  PSTR("D/5.3    "));
-        }
-        else if(channelIndex > 31)
+    widgets[WIDGET_SEEK_MARKER].update(channel * 5/2);
 #else
-        if(channelIndex > 31)
+    widgets[WIDGET_SEEK_MARKER].update(channel * 3);
 #endif
-        {
-            TV.printPGM(50,TV_Y_OFFSET+1*TV_Y_GRID,  PSTR("C/Race   "));
-        }
-        else if(channelIndex > 23)
-        {
-            TV.printPGM(50,TV_Y_OFFSET+1*TV_Y_GRID,  PSTR("F/Airwave"));
-        }
-        else if (channelIndex > 15)
-        {
-            TV.printPGM(50,TV_Y_OFFSET+1*TV_Y_GRID,  PSTR("E        "));
-        }
-        else if (channelIndex > 7)
-        {
-            TV.printPGM(50,TV_Y_OFFSET+1*TV_Y_GRID,  PSTR("B        "));
-        }
-        else
-        {
-            TV.printPGM(50,TV_Y_OFFSET+1*TV_Y_GRID,  PSTR("A        "));
-        }
-        // show channel inside band
-        uint8_t active_channel = channelIndex%CHANNEL_BAND_SIZE; // get channel inside band
+    // show frequence
+    widgets[WIDGET_SEEK_FREQUENCY].update(channelFrequency);
 
-        TV.draw_rect(1 ,TV_Y_OFFSET-2+2*TV_Y_GRID,125,12,  BLACK, BLACK); // mark current channel
-        TV.printPGM(5 ,TV_Y_OFFSET-1+2*TV_Y_GRID,  PSTR("1 2 3 4 5 6 7 8"));
-        // set new marker
-        TV.draw_rect(active_channel*16+2 ,TV_Y_OFFSET-2+2*TV_Y_GRID,12,12,  WHITE, INVERT); // mark current channel
+    // show signal strength
+    widgets[WIDGET_SEEK_RSSI].update(map(rssi, 1, 100, 1, RSSI_BAR_SIZE));
 
-        // clear last square
-        TV.draw_rect(1, (TV_ROWS - TV_SCANNER_OFFSET + 8),125,SCANNER_MARKER_SIZE,  BLACK, BLACK);
-        // draw next
+    // print bar for spectrum
+    uint8_t rssi_scaled=map(rssi, 1, 100, 1, SCANNER_BAR_MINI_SIZE);
+    if(channelIndex != last_channel || rssi_scaled != last_rssi)
+    {
 #ifdef USE_LBAND
-        TV.draw_rect((channel * 5/2)+5, (TV_ROWS - TV_SCANNER_OFFSET + 8),SCANNER_MARKER_SIZE,SCANNER_MARKER_SIZE,  WHITE, WHITE);
-
+        // clear last bar
+        TV.draw_rect((channel * 5/2)+4, (TV_ROWS - TV_SCANNER_OFFSET - SCANNER_BAR_MINI_SIZE), 2, SCANNER_BAR_MINI_SIZE , BLACK, BLACK);
+        //  draw new bar
+        TV.draw_rect((channel * 5/2)+4, (TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled), 2, rssi_scaled , WHITE, WHITE);
 #else
-        TV.draw_rect((channel * 3)+5, (TV_ROWS - TV_SCANNER_OFFSET + 8),SCANNER_MARKER_SIZE,SCANNER_MARKER_SIZE,  WHITE, WHITE);
-
+        // clear last bar
+        TV.draw_rect((channel * 3)+4, (TV_ROWS - TV_SCANNER_OFFSET - SCANNER_BAR_MINI_SIZE), 2, SCANNER_BAR_MINI_SIZE , BLACK, BLACK);
+        //  draw new bar
+        TV.draw_rect((channel * 3)+4, (TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled), 2, rssi_scaled , WHITE, WHITE);
 #endif
-        // show frequence
-        TV.print(50,TV_Y_OFFSET+3*TV_Y_GRID, channelFrequency);
     }
-    // show signal strength
-    #define RSSI_BAR_SIZE 100
-    uint8_t rssi_scaled=map(rssi, 1, 100, 1, RSSI_BAR_SIZE);
-    // clear last bar
-    TV.draw_rect(25, TV_Y_OFFSET+4*TV_Y_GRID, RSSI_BAR_SIZE,4 , BLACK, BLACK);
-    //  draw new bar
-    TV.draw_rect(25, TV_Y_OFFSET+4*TV_Y_GRID, rssi_scaled, 4 , WHITE, WHITE);
-    // print bar for spectrum
+    // handling for seek mode after screen and RSSI has been fully processed
+    if(state == STATE_SEEK)
+    { // SEEK MODE
+        uint8_t threshold_scaled=map(rssi_seek_threshold, 1, 100, 1, SCANNER_BAR_MINI_SIZE);
 
-    #define SCANNER_BAR_MINI_SIZE 14
+        widgets[WIDGET_SEEK_THRESHOLD_LEFT].update(SCANNER_BAR_MINI_SIZE-threshold_scaled);
+        widgets[WIDGET_SEEK_THRESHOLD_RIGHT].update(SCANNER_BAR_MINI_SIZE-threshold_scaled);
+        if(locked) {
+            widgets[WIDGET_SEEK_TITLE].update(PSTR("AUTO MODE LOCK"), WIDGET_INVERT);
+        }
+        else
+        {
+            widgets[WIDGET_SEEK_TITLE].update(PSTR("AUTO MODE SEEK"), WIDGET_INVERT);
+        }
+    }
 
-    rssi_scaled=map(rssi, 1, 100, 1, SCANNER_BAR_MINI_SIZE);
+    last_channel = channelIndex;
+    last_rssi = rssi_scaled;
+}
 
- 
+#ifdef USE_SCOUT
+template<> void tvScreens::updateScout(uint8_t channel, uint8_t rssi) {
+    uint8_t rssi_scaled=map(rssi, 1, 100, 1, SCANNER_BAR_MINI_SIZE);
 #ifdef USE_LBAND
-    // clear last bar
     TV.draw_rect((channel * 5/2)+4, (TV_ROWS - TV_SCANNER_OFFSET - SCANNER_BAR_MINI_SIZE), 2, SCANNER_BAR_MINI_SIZE , BLACK, BLACK);
-    //  draw new bar
     TV.draw_rect((channel * 5/2)+4, (TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled), 2, rssi_scaled , WHITE, WHITE);
 #else
-   // clear last bar
     TV.draw_rect((channel * 3)+4, (TV_ROWS - TV_SCANNER_OFFSET - SCANNER_BAR_MINI_SIZE), 2, SCANNER_BAR_MINI_SIZE , BLACK, BLACK);
-    //  draw new bar
     TV.draw_rect((channel * 3)+4, (TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled), 2, rssi_scaled , WHITE, WHITE);
 #endif
-    // handling for seek mode after screen and RSSI has been fully processed
-    if(state == STATE_SEEK)
-    { // SEEK MODE
-
-        rssi_scaled=map(rssi_seek_threshold, 1, 100, 1, SCANNER_BAR_MINI_SIZE);
-
-        TV.draw_rect(1,(TV_ROWS - TV_SCANNER_OFFSET - SCANNER_BAR_MINI_SIZE),2,SCANNER_BAR_MINI_SIZE-1,BLACK,BLACK);
-        TV.draw_line(1,(TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled),3,(TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled), WHITE);
-        TV.draw_rect(TV_X_MAX-2,(TV_ROWS - TV_SCANNER_OFFSET - SCANNER_BAR_MINI_SIZE),1,SCANNER_BAR_MINI_SIZE-1,BLACK,BLACK);
-        TV.draw_line(TV_X_MAX-2,(TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled),TV_X_MAX,(TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled), WHITE);
-        if(last_channel != channelIndex) {
-            // fix title flicker
-            TV.draw_rect(0,0,127,14, WHITE,BLACK);
-            if(locked) {
-                TV.printPGM(((127-14*8)/2), TV_Y_OFFSET,  PSTR("AUTO MODE LOCK"));
-            }
-            else
-            {
-                TV.printPGM(((127-14*8)/2), TV_Y_OFFSET,  PSTR("AUTO MODE SEEK"));
-            }
-            TV.draw_rect(0,0,127,14,  WHITE,INVERT);
-        }
-    }
-
-    last_channel = channelIndex;
 }
+#endif
 
-void screens::bandScanMode(uint8_t state) {
+template<> void tvScreens::bandScanMode(uint8_t state) {
     reset(); // start from fresh screen.
     best_rssi = 0;
     if(state==STATE_SCAN)
@@ -264,21 +315,21 @@ void screens::bandScanMode(uint8_t state) {
     {
         drawTitleBox(PSTR("RSSI SETUP"));
     }
-    TV.select_font(font8x8);
+    selectFont(font8x8);
     if(state==STATE_SCAN)
     {
-        TV.select_font(font4x6);
+        selectFont(font4x6);
         TV.draw_line(50,1*TV_Y_GRID,50, 1*TV_Y_GRID+9,WHITE);
         TV.printPGM(2, SCANNER_LIST_Y_POS, PSTR("BEST:"));
     }
     else
     {
-        TV.select_font(font4x6);
+        selectFont(font4x6);
         TV.printPGM(10, SCANNER_LIST_Y_POS, PSTR("RSSI Min:     RSSI Max:   "));
     }
     TV.draw_rect(0,1*TV_Y_GRID,TV_X_MAX,9,  WHITE); // list frame
     TV.draw_rect(0,TV_ROWS - TV_SCANNER_OFFSET,TV_X_MAX,13,  WHITE); // lower frame
-    TV.select_font(font4x6);
+    selectFont(font4x6);
 #ifdef USE_LBAND
     TV.printPGM(2, (TV_ROWS - TV_SCANNER_OFFSET + 2), PSTR("5362"));
 #else
@@ -286,24 +337,23 @@ void screens::bandScanMode(uint8_t state) {
 #endif
     TV.printPGM(57, (TV_ROWS - TV_SCANNER_OFFSET + 2), PSTR("5800"));
     TV.printPGM(111, (TV_ROWS - TV_SCANNER_OFFSET + 2), PSTR("5945"));
+
+    widgets[WIDGET_SCAN_NAME].number(22, SCANNER_LIST_Y_POS, 2*4, 6, WIDGET_HEX);
+    widgets[WIDGET_SCAN_FREQUENCY].number(32, SCANNER_LIST_Y_POS, 4*4, 6, 0);
+    widgets[WIDGET_SCAN_MIN].number(50, SCANNER_LIST_Y_POS, 3*4, 6, 0);
+    widgets[WIDGET_SCAN_MAX].number(110, SCANNER_LIST_Y_POS, 3*4, 6, 0);
+    widgets[WIDGET_SCAN_MARKER].marker(5, TV_ROWS - TV_SCANNER_OFFSET + 8, SCANNER_MARKER_SIZE+1, SCANNER_MARKER_SIZE+1, 0);
 }
 
-void screens::updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, uint8_t channelName, uint16_t channelFrequency, uint16_t rssi_setup_min_a, uint16_t rssi_setup_max_a) {
+template<> void tvScreens::updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, uint8_t channelName, uint16_t channelFrequency, uint16_t rssi_setup_min_a, uint16_t rssi_setup_max_a) {
     // force tune on new scan start to get right RSSI value
     static uint8_t writePos=SCANNER_LIST_X_POS;
     // channel marker
-    if(channel != last_channel) // only updated on changes
-    {
-        // clear last square
-        TV.draw_rect(1, (TV_ROWS - TV_SCANNER_OFFSET + 8),125,SCANNER_MARKER_SIZE,  BLACK, BLACK);
 #ifdef USE_LBAND
-        // draw next
-        TV.draw_rect((channel * 5/2)+5, (TV_ROWS - TV_SCANNER_OFFSET + 8),SCANNER_MARKER_SIZE,SCANNER_MARKER_SIZE,  WHITE, WHITE);
+    widgets[WIDGET_SCAN_MARKER].update(channel * 5/2);
 #else
-        // draw next
-        TV.draw_rect((channel * 3)+5, (TV_ROWS - TV_SCANNER_OFFSET + 8),SCANNER_MARKER_SIZE,SCANNER_MARKER_SIZE,  WHITE, WHITE);
+    widgets[WIDGET_SCAN_MARKER].update(channel * 3);
 #endif
-    }
     // print bar for spectrum
 
     uint8_t rssi_scaled=map(rssi, 1, 100, 5, SCANNER_BAR_SIZE);
@@ -317,8 +367,8 @@ void screens::updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, u
         if (rssi > RSSI_SEEK_TRESHOLD) {
             if(best_rssi < rssi) {
                 best_rssi = rssi;
-                TV.print(22, SCANNER_LIST_Y_POS, channelName, HEX);
-                TV.print(32, SCANNER_LIST_Y_POS, channelFrequency);
+                widgets[WIDGET_SCAN_NAME].update(channelName);
+                widgets[WIDGET_SCAN_FREQUENCY].update(channelFrequency);
             }
             else {
                 if(writePos+10>TV_COLS-2)
@@ -326,28 +376,22 @@ void screens::updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, u
                     writePos=SCANNER_LIST_X_POS;
                 }
                 TV.draw_rect(writePos, SCANNER_LIST_Y_POS, 8, 6,  BLACK, BLACK);
-                TV.print(writePos, SCANNER_LIST_Y_POS, channelName, HEX);
+                printNumber(writePos, SCANNER_LIST_Y_POS, channelName, NUM_HEX);
                 writePos += 10;
             }
             TV.draw_rect((channel * 3) - 5, (TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled) - 5, 8, 7,  BLACK, BLACK);
-            TV.print((channel * 3) - 4, (TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled) - 5, channelName, HEX);
+            printNumber((channel * 3) - 4, (TV_ROWS - TV_SCANNER_OFFSET - rssi_scaled) - 5, channelName, NUM_HEX);
         }
     }
     else {
-            TV.print(50, SCANNER_LIST_Y_POS, "   ");
-            TV.print(50, SCANNER_LIST_Y_POS, rssi_setup_min_a , DEC);
-
-            TV.print(110, SCANNER_LIST_Y_POS, "   ");
-            TV.print(110, SCANNER_LIST_Y_POS, rssi_setup_max_a , DEC);
+        widgets[WIDGET_SCAN_MIN].update(rssi_setup_min_a);
+        widgets[WIDGET_SCAN_MAX].update(rssi_setup_max_a);
     }
 
     last_channel = channel;
 }
 
-void screens::screenSaver(uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
-    screenSaver(-1, channelName, channelFrequency, call_sign);
-}
-void screens::screenSaver(uint8_t diversity_mode, uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
+template<> void tvScreens::screenSaver(uint8_t diversity_mode, uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
  // not used in TVOut ... yet
 /*    reset();
     TV.select_font(font8x8);
@@ -377,20 +421,25 @@ void screens::screenSaver(uint8_t diversity_mode, uint8_t channelName, uint16_t
 */
 }
 
-void screens::updateScreenSaver(uint8_t rssi) {
-    updateScreenSaver(-1, rssi, -1, -1);
+template<> void tvScreens::screenSaver(uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
+    screenSaver(-1, channelName, channelFrequency, call_sign);
 }
-void screens::updateScreenSaver(char active_receiver, uint8_t rssi, uint8_t rssiA, uint8_t rssiB) {
+
+template<> void tvScreens::updateScreenSaver(char active_receiver, uint8_t rssi, uint8_t rssiA, uint8_t rssiB) {
 // not used in TVOut ... yet
 }
+
+template<> void tvScreens::updateScreenSaver(uint8_t rssi) {
+    updateScreenSaver(-1, rssi, -1, -1);
+}
 #ifdef USE_VOLTAGE_MONITORING
-void screens::updateVoltageScreenSaver(int voltage, boolean alarm){
+template<> void tvScreens::updateVoltageScreenSaver(int voltage, boolean alarm){
 // not used in TVOut ... yet
 }
 #endif
 
 #ifdef USE_DIVERSITY
-void screens::diversity(uint8_t diversity_mode) {
+template<> void tvScreens::diversity(uint8_t diversity_mode) {
     reset();
     drawTitleBox(PSTR("DIVERSITY"));
     TV.printPGM(10, 5+1*MENU_Y_SIZE, PSTR("Auto"));
@@ -403,50 +452,41 @@ void screens::diversity(uint8_t diversity_mode) {
     TV.printPGM(10, 6+5*MENU_Y_SIZE, PSTR("B:"));
 
     TV.draw_rect(0,3+(diversity_mode+1)*MENU_Y_SIZE,127,12,  WHITE, INVERT);
-}
-void screens::updateDiversity(char active_receiver, uint8_t rssiA, uint8_t rssiB){
-    #define RSSI_BAR_SIZE 100
-    uint8_t rssi_scaled=map(rssiA, 1, 100, 1, RSSI_BAR_SIZE);
-    // clear last bar
-    TV.draw_rect(25+rssi_scaled, 6+4*MENU_Y_SIZE, RSSI_BAR_SIZE-rssi_scaled, 8 , BLACK, BLACK);
-    //  draw new bar
-    TV.draw_rect(25, 6+4*MENU_Y_SIZE, rssi_scaled, 8 , WHITE, (active_receiver==useReceiverA ? WHITE:BLACK));
-
-    // read rssi B
-    rssi_scaled=map(rssiB, 1, 100, 1, RSSI_BAR_SIZE);
-    // clear last bar
-    TV.draw_rect(25+rssi_scaled, 6+5*MENU_Y_SIZE, RSSI_BAR_SIZE-rssi_scaled, 8 , BLACK, BLACK);
-    //  draw new bar
-    TV.draw_rect(25, 6+5*MENU_Y_SIZE, rssi_scaled, 8 , WHITE, (active_receiver==useReceiverB ? WHITE:BLACK));
 
+    widgets[WIDGET_RSSI_A].bar(25, 6+4*MENU_Y_SIZE, RSSI_BAR_SIZE+1, 9, 0);
+    widgets[WIDGET_RSSI_B].bar(25, 6+5*MENU_Y_SIZE, RSSI_BAR_SIZE+1, 9, 0);
+}
+template<> void tvScreens::updateDiversity(char active_receiver, uint8_t rssiA, uint8_t rssiB){
+    widgets[WIDGET_RSSI_A].update(map(rssiA, 1, 100, 1, RSSI_BAR_SIZE), active_receiver == useReceiverA ? 0 : WIDGET_OUTLINE);
+    widgets[WIDGET_RSSI_B].update(map(rssiB, 1, 100, 1, RSSI_BAR_SIZE), active_receiver == useReceiverB ? 0 : WIDGET_OUTLINE);
 }
 #endif
 
 #ifdef USE_VOLTAGE_MONITORING
-void screens::voltage(uint8_t menu_id, int voltage_calibration, uint8_t warning_voltage, uint8_t critical_voltage) {
+template<> void tvScreens::voltage(uint8_t menu_id, int voltage_calibration, uint8_t warning_voltage, uint8_t critical_voltage) {
     reset();
     drawTitleBox(PSTR("VOLTAGE ALARM"));
     TV.printPGM(5, 5+1*MENU_Y_SIZE, PSTR("Warning"));
-    TV.print(5+(11*8), 5+1*MENU_Y_SIZE, (float)warning_voltage/10.0, 1);
+    printNumber(5+(11*8), 5+1*MENU_Y_SIZE, warning_voltage, NUM_DECIMAL);
     TV.printPGM(5, 5+2*MENU_Y_SIZE, PSTR("Critical"));
-    TV.print(5+(11*8), 5+2*MENU_Y_SIZE, (float)critical_voltage/10.0, 1);
+    printNumber(5+(11*8), 5+2*MENU_Y_SIZE, critical_voltage, NUM_DECIMAL);
     TV.printPGM(5, 5+3*MENU_Y_SIZE, PSTR("Calibrate"));
-    TV.print(5+(11*8), 5+3*MENU_Y_SIZE, voltage_calibration, 10);
+    printNumber(5+(11*8), 5+3*MENU_Y_SIZE, voltage_calibration);
     TV.printPGM(5, 5+4*MENU_Y_SIZE, PSTR("Save"));
 
     TV.draw_rect(0,3+(menu_id+1)*MENU_Y_SIZE,127,12,  WHITE, INVERT);
 }
-void screens::updateVoltage(int voltage){
+template<> void tvScreens::updateVoltage(int voltage){
 
     TV.printPGM(5, 10+5*MENU_Y_SIZE, PSTR("Measured"));
-    TV.print(5+(11*8), 10+5*MENU_Y_SIZE, (float)voltage/10, 1);
+    printNumber(5+(11*8), 10+5*MENU_Y_SIZE, voltage, NUM_DECIMAL);
 
 }
 #endif
 
-void screens::setupMenu(){
+template<> void tvScreens::setupMenu(){
 }
-void screens::updateSetupMenu(uint8_t menu_id,bool settings_beeps,bool settings_orderby_channel, const char *call_sign, char editing){
+template<> void tvScreens::updateSetupMenu(uint8_t menu_id,bool settings_beeps,bool settings_orderby_channel, const char *call_sign, char editing){
     reset();
     drawTitleBox(PSTR("SETUP MENU"));
 
@@ -495,7 +535,7 @@ void screens::updateSetupMenu(uint8_t menu_id,bool settings_beeps,bool settings_
     TV.draw_rect(0,3+(menu_id+1)*MENU_Y_SIZE,127,12,  WHITE, INVERT);
 }
 
-void screens::save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency, const char *call_sign) {
+template<> void tvScreens::save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency, const char *call_sign) {
     reset();
     drawTitleBox(PSTR("SAVE SETTINGS"));
     TV.printPGM(10, 5+1*MENU_Y_SIZE, PSTR("Mode:"));
@@ -539,16 +579,41 @@ void screens::save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency
     }
     TV.printPGM(10, 5+3*MENU_Y_SIZE, PSTR("Chan:"));
     uint8_t active_channel = channelIndex%CHANNEL_BAND_SIZE+1; // get channel inside band
-    TV.print(50,5+3*MENU_Y_SIZE,active_channel,DEC);
+    printNumber(50,5+3*MENU_Y_SIZE,active_channel);
     TV.printPGM(10, 5+4*MENU_Y_SIZE, PSTR("FREQ:     GHz"));
-    TV.print(50,5+4*MENU_Y_SIZE, channelFrequency);
+    printNumber(50,5+4*MENU_Y_SIZE, channelFrequency);
     TV.printPGM(10, 5+5*MENU_Y_SIZE, PSTR("--- SAVED ---"));
 }
 
-void screens::updateSave(const char * msg) {
-    TV.select_font(font4x6);
+template<> void tvScreens::updateSave(const char * msg) {
+    selectFont(font4x6);
     TV.print(((127-strlen(msg)*4)/2), 14+5*MENU_Y_SIZE, msg);
 }
 
+#ifdef USE_INSTRUMENTS
+#define INSTRUMENTS_Y(row) (17+(row)*9)
+template<> void tvScreens::instruments() {
+    reset();
+    drawTitleBox(PSTR("INSTRUMENTS"));
+    TV.printPGM(5, INSTRUMENTS_Y(0), PSTR("LOOPS/S"));
+    TV.printPGM(5, INSTRUMENTS_Y(1), PSTR("ADC/S"));
+    TV.printPGM(5, INSTRUMENTS_Y(2), PSTR("SWITCH/S"));
+    TV.printPGM(5, INSTRUMENTS_Y(3), PSTR("FREE RAM"));
+    TV.printPGM(5, INSTRUMENTS_Y(4), PSTR("RSSI US"));
+    TV.printPGM(5, INSTRUMENTS_Y(5), PSTR("TUNE US"));
+    TV.printPGM(5, INSTRUMENTS_Y(6), PSTR("DRAW US"));
+    TV.printPGM(5, INSTRUMENTS_Y(7), PSTR("EEPROM US"));
+}
+
+template<> void tvScreens::updateInstruments(uint16_t loops, uint16_t adc_reads, uint16_t switches, uint16_t free_ram, uint16_t rssi_time, uint16_t tune_time, uint16_t draw_time, uint16_t eeprom_time) {
+    uint16_t values[] = { loops, adc_reads, switches, free_ram, rssi_time, tune_time, draw_time, eeprom_time };
+    for(uint8_t row = 0; row < 8; row++) {
+        TV.draw_rect(5+9*8, INSTRUMENTS_Y(row), 5*8, 7, BLACK, BLACK);
+        printNumber(5+9*8, INSTRUMENTS_Y(row), values[row]);
+    }
+}
+#undef INSTRUMENTS_Y
+#endif
+
 
 #endif
@@ -0,0 +1,268 @@
+/*
+ * ADC driver by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+#include "adc.h"
+#include "instruments.h"
+#ifdef USE_SLEEP
+#include "power.h"
+#endif
+
+// ADPS bits of ADCSRA, the prescaler is 2^bits
+#define ADC_PRESCALER_BITS(prescaler) ((prescaler) == 16 ? 4 : (prescaler) == 32 ? 5 : (prescaler) == 64 ? 6 : 7)
+// REFS bits of ADMUX, the same values as DEFAULT and INTERNAL of analogReference()
+#define ADC_REFS(reference) ((reference) == 1100 ? 3 : 1)
+#define ADC_REFERENCE_SETTLE 20 // ms, AREF charges through its capacitor
+
+#ifdef ADC_DISCARD_FIRST
+#define ADC_DISCARD 1
+static uint8_t adc_pin = 0xFF; // input of the last read
+#else
+#define ADC_DISCARD 0
+#endif
+static volatile bool adc_busy = false; // the main loop is converting
+static uint8_t adc_refs = ADC_REFS(5000); // the arduino default after reset
+
+// conversions of adcStart(), collected on a later tick
+#define ADC_IDLE 0
+#define ADC_STARTED 1
+#define ADC_SETTLING 2 // discarded, the input changed
+#define ADC_HELD 3 // the main loop finishes it before its own
+#define ADC_READY 4 // finished by the main loop, in adc_value
+static volatile uint8_t adc_state = ADC_IDLE;
+static volatile uint16_t adc_value;
+
+static void adcPrescaler(uint8_t bits) {
+    ADCSRA = (ADCSRA & ~0x07) | bits;
+}
+
+#ifdef USE_SLEEP
+static uint16_t adcConvert(uint8_t pin);
+#else
+#define adcConvert analogRead
+#endif
+
+static void adcReference(uint8_t refs) {
+    adc_refs = refs;
+    analogReference(refs);
+    // the reads right after the switch are off
+    adcConvert(rssiPinA);
+    delay(ADC_REFERENCE_SETTLE);
+}
+
+void adcBegin() {
+    adcPrescaler(ADC_PRESCALER_BITS(ADC_PRESCALER));
+    if(adc_refs != ADC_REFS(ADC_REFERENCE)) {
+        adcReference(ADC_REFS(ADC_REFERENCE));
+    }
+#ifdef ADC_DISCARD_FIRST
+    adc_pin = 0xFF;
+#endif
+}
+
+#ifdef USE_SLEEP
+EMPTY_INTERRUPT(ADC_vect); // only wakes the CPU
+
+// analogRead() asleep instead of polling the ADC
+static uint16_t adcConvert(uint8_t pin) {
+    if(pin >= A0) {
+        pin -= A0;
+    }
+    ADMUX = (adc_refs << 6) | (pin & 0x07);
+    ADCSRA |= _BV(ADSC) | _BV(ADIE);
+    for(;;) {
+        cli();
+        if(!(ADCSRA & _BV(ADSC))) {
+            sei();
+            break;
+        }
+        powerSleep(); // other interrupts wake us as well
+    }
+    ADCSRA &= ~_BV(ADIE);
+    return ADC;
+}
+#endif
+
+static uint16_t adcRead(uint8_t pin, bool discard) {
+    if(discard) {
+        // the sample and hold needs one conversion to follow the new input
+        adcConvert(pin);
+    }
+    return adcConvert(pin);
+}
+
+uint16_t adcRead(uint8_t pin) {
+    INSTR_COUNT(INSTR_ADC_READS);
+    adc_busy = true;
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t state = adc_state;
+    if(state == ADC_STARTED || state == ADC_SETTLING) {
+        adc_state = ADC_HELD;
+    }
+    SREG = sreg;
+    if(state == ADC_STARTED || state == ADC_SETTLING) {
+        // polled with the interrupts on, the tick collects it later
+        while(ADCSRA & _BV(ADSC));
+        adc_value = ADC;
+        adc_state = state == ADC_STARTED ? ADC_READY : ADC_IDLE;
+    }
+#ifdef ADC_DISCARD_FIRST
+    bool discard = pin != adc_pin;
+    adc_pin = pin;
+    uint16_t value = adcRead(pin, discard);
+#else
+    uint16_t value = adcConvert(pin);
+#endif
+    adc_busy = false;
+    return value;
+}
+
+static void adcConvertStart(uint8_t pin) {
+    if(pin >= A0) {
+        pin -= A0;
+    }
+    ADMUX = (adc_refs << 6) | (pin & 0x07);
+    ADCSRA |= _BV(ADSC);
+}
+
+bool adcStart(uint8_t pin) {
+    if(adc_busy || adc_state != ADC_IDLE) {
+        return false;
+    }
+    adc_state = ADC_STARTED;
+#ifdef ADC_DISCARD_FIRST
+    if(pin != adc_pin) {
+        adc_state = ADC_SETTLING;
+        adc_pin = pin;
+    }
+#endif
+    adcConvertStart(pin);
+    return true;
+}
+
+bool adcCollect(uint16_t *value) {
+    uint8_t state = adc_state;
+    if(state == ADC_READY) {
+        *value = adc_value;
+        adc_state = ADC_IDLE;
+        return true;
+    }
+    if((state != ADC_STARTED && state != ADC_SETTLING) || (ADCSRA & _BV(ADSC))) {
+        return false;
+    }
+#ifdef ADC_DISCARD_FIRST
+    if(state == ADC_SETTLING) {
+        adc_state = ADC_STARTED; // once more on the settled input
+        adcConvertStart(adc_pin);
+        return false;
+    }
+#endif
+    *value = ADC;
+    adc_state = ADC_IDLE;
+    return true;
+}
+
+#ifdef USE_ADC_SELF_TEST
+#define ADC_TEST_READS 256
+
+static uint16_t isqrt(uint32_t value) {
+    uint16_t root = 0;
+    for(uint16_t bit = 0x8000; bit; bit >>= 1) {
+        if((uint32_t)(root | bit) * (root | bit) <= value) {
+            root |= bit;
+        }
+    }
+    return root;
+}
+
+// mean and standard deviation in tenths of an adc step
+static void printStats(uint32_t sum, uint32_t squares) {
+    // N^2*variance = N*squares - sum^2 in 64 bit, an integer mean would
+    // drop up to a whole step from the variance.
+    uint64_t spread = (uint64_t)ADC_TEST_READS * squares - (uint64_t)sum * sum;
+    Serial.print(' ');
+    Serial.print(sum / ADC_TEST_READS);
+    Serial.print(' ');
+    Serial.print(isqrt(spread * 100 / ((uint32_t)ADC_TEST_READS * ADC_TEST_READS)));
+}
+
+void adcSelfTest() {
+    // sd in tenths of a step, a step is ref/1024 mV
+    Serial.println("ADC ref/mV prescaler discard us/read meanA sdA/10"
+#ifdef USE_DIVERSITY
+        " meanB sdB/10"
+#endif
+    );
+    const uint16_t references[] = { 5000, 1100 };
+    for(uint8_t r = 0; r < 2; r++) {
+        adcReference(ADC_REFS(references[r]));
+        for(uint8_t bits = 4; bits <= 7; bits++) {
+            for(uint8_t discard = 0; discard < 2; discard++) {
+                uint32_t sum_a = 0, squares_a = 0;
+#ifdef USE_DIVERSITY
+                uint32_t sum_b = 0, squares_b = 0;
+#endif
+                adcPrescaler(bits);
+                // alternating inputs like readRSSI()
+                unsigned long start = micros();
+                for(uint16_t i = 0; i < ADC_TEST_READS; i++) {
+                    uint16_t value = adcRead(rssiPinA, discard);
+                    sum_a += value;
+                    squares_a += (uint32_t)value * value;
+#ifdef USE_DIVERSITY
+                    value = adcRead(rssiPinB, discard);
+                    sum_b += value;
+                    squares_b += (uint32_t)value * value;
+#endif
+                }
+                unsigned long time = micros() - start;
+                // the configured setting is marked
+                bool configured = references[r] == ADC_REFERENCE && bits == ADC_PRESCALER_BITS(ADC_PRESCALER) && discard == ADC_DISCARD;
+                Serial.print(configured ? "*ADC " : "ADC ");
+                Serial.print(references[r]);
+                Serial.print(' ');
+                Serial.print(1 << bits);
+                Serial.print(' ');
+                Serial.print(discard);
+                Serial.print(' ');
+#ifdef USE_DIVERSITY
+                Serial.print(time / (ADC_TEST_READS * 2));
+#else
+                Serial.print(time / ADC_TEST_READS);
+#endif
+                printStats(sum_a, squares_a);
+#ifdef USE_DIVERSITY
+                printStats(sum_b, squares_b);
+#endif
+                Serial.println();
+            }
+        }
+    }
+    adcBegin();
+}
+#endif
@@ -0,0 +1,51 @@
+/*
+ * ADC driver by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef adc_h
+#define adc_h
+
+#include <stdint.h>
+
+// ADC driver
+// The rssi reads go through adcRead() so the converter clock can be set
+// with ADC_PRESCALER and the reference with ADC_REFERENCE. Faster clocks
+// give more reads per channel but more noise, adcSelfTest() measures both
+// for every prescaler and reference.
+
+void adcBegin(); // sets the prescaler and the reference
+uint16_t adcRead(uint8_t pin);
+// reads of an interrupt, the conversion runs between two calls so the
+// interrupt never waits for it. adcStart() is false while the main loop
+// is in adcRead() or the last conversion was not collected, adcCollect()
+// is false until the conversion has finished.
+bool adcStart(uint8_t pin);
+bool adcCollect(uint16_t *value);
+#ifdef USE_ADC_SELF_TEST
+// reads the rssi pins at every prescaler and reference and prints time and noise.
+void adcSelfTest();
+#endif
+
+#endif
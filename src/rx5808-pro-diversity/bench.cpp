@@ -0,0 +1,220 @@
+/*
+ * Benchmarks by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "settings.h"
+
+#ifdef USE_BENCHMARK
+#include "bench.h"
+#include "adc.h"
+#include "screens.h"
+#include "numfmt.h"
+#include "channels.h"
+#ifdef USE_RSSI_FILTER
+#include "rssi.h"
+#endif
+
+#if !defined(TVOUT_SCREENS) && !defined(AUTO_SCREENS)
+    #define BENCH_TIMER1
+#endif
+
+// main project
+extern screens drawScreen;
+extern uint8_t channelIndex;
+void setChannelModule(uint8_t channel);
+uint16_t readRSSI();
+
+#ifdef BENCH_TIMER1
+static volatile uint16_t bench_overflows = 0;
+
+ISR(TIMER1_OVF_vect) {
+    bench_overflows++;
+}
+
+static uint32_t benchCycles() {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t count = TCNT1;
+    uint16_t overflows = bench_overflows;
+    if((TIFR1 & _BV(TOV1)) && count < 0x8000) {
+        overflows++; // the overflow interrupt is still pending
+    }
+    SREG = sreg;
+    return ((uint32_t)overflows << 16) | count;
+}
+#else
+static uint32_t benchCycles() {
+    return micros() * (F_CPU / 1000000L);
+}
+#endif
+
+static uint8_t bench_rssi = 0;
+static uint16_t bench_number = 0;
+static char bench_text[NUM_SIZE];
+
+static void benchEmpty() {
+}
+
+static void benchTune() {
+    setChannelModule(channelIndex);
+}
+
+static void benchReadRSSI() {
+    readRSSI();
+}
+
+static void benchAdcRead() {
+    adcRead(rssiPinA);
+}
+
+static void benchScreenDraw() {
+    drawScreen.seekMode(STATE_MANUAL);
+}
+
+static void benchScreenUpdate() {
+    // a new rssi every run, the bar and the graph have to be drawn
+    bench_rssi = bench_rssi >= 100 ? 1 : bench_rssi + 7;
+    drawScreen.updateSeekMode(STATE_MANUAL, channelIndex, 0, bench_rssi, pgm_read_word_near(channelFreqTable + channelIndex), RSSI_SEEK_TRESHOLD, false);
+}
+
+static void benchNumFormat() {
+    bench_number += 1237; // other digits every run
+    numFormat(bench_text, bench_number, 0);
+}
+
+// the digits the way Print::printNumber() gets them, for comparison
+static void benchPrintDigits() {
+    bench_number += 1237;
+    unsigned long n = bench_number;
+    char *digit = bench_text + sizeof(bench_text) - 1;
+    *digit = '\0';
+    do {
+        char c = n % 10;
+        n /= 10;
+        *--digit = '0' + c;
+    } while(n);
+}
+
+#ifdef USE_RSSI_FILTER
+// one window of RSSI_FILTER_WINDOW reads, other values every run. The
+// cycles per read are the cycles of a run over RSSI_FILTER_WINDOW.
+static uint16_t bench_window[RSSI_FILTER_WINDOW];
+static uint16_t bench_filtered = 0;
+
+static void benchWindow() {
+    for(uint8_t i = 0; i < RSSI_FILTER_WINDOW; i++) {
+        bench_window[i] = (bench_number += 1237) >> 6;
+    }
+}
+
+static void benchFilterMean() {
+    benchWindow();
+    uint16_t sum = 0;
+    for(uint8_t i = 0; i < RSSI_FILTER_WINDOW; i++) {
+        sum += bench_window[i];
+    }
+    bench_filtered = sum / RSSI_FILTER_WINDOW;
+}
+
+static void benchFilterMedian() {
+    benchWindow();
+    bench_filtered = rssiFilter(bench_window, RSSI_FILTER_MEDIAN);
+}
+
+static void benchFilterTrimmed() {
+    benchWindow();
+    bench_filtered = rssiFilter(bench_window, RSSI_FILTER_TRIMMED);
+}
+#endif
+
+static void benchEEPROMWrite() {
+    // the same value again, a write erases and programs anyway
+    EEPROM.write(EEPROM_ADR_TUNE, EEPROM.read(EEPROM_ADR_TUNE));
+}
+
+static void bench(const __FlashStringHelper *name, void (*function)(), uint8_t runs) {
+    uint32_t least = 0xFFFFFFFF;
+    uint32_t most = 0;
+    uint32_t sum = 0;
+    for(uint8_t i = 0; i < runs; i++) {
+        uint32_t start = benchCycles();
+        function();
+        uint32_t cycles = benchCycles() - start;
+        least = cycles < least ? cycles : least;
+        most = cycles > most ? cycles : most;
+        sum += cycles;
+    }
+    Serial.print(F("BENCH "));
+    Serial.print(name);
+    Serial.print(' ');
+    Serial.print(runs);
+    Serial.print(' ');
+    Serial.print(least);
+    Serial.print(' ');
+    Serial.print((sum + runs/2) / runs);
+    Serial.print(' ');
+    Serial.println(most);
+    Serial.flush();
+}
+
+void benchmarkRun() {
+#ifdef BENCH_TIMER1
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10); // no prescaler, one count per cycle
+    TCNT1 = 0;
+    TIFR1 = _BV(TOV1);
+    TIMSK1 = _BV(TOIE1);
+    Serial.print(F("BENCH_BEGIN timer1 "));
+#else
+    Serial.print(F("BENCH_BEGIN micros "));
+#endif
+    Serial.println(F_CPU);
+    Serial.flush(); // sending would interrupt the first runs
+
+    bench(F("empty"), benchEmpty, BENCH_RUNS);
+    bench(F("setChannelModule"), benchTune, BENCH_RUNS);
+    bench(F("adcRead"), benchAdcRead, BENCH_RUNS);
+    bench(F("readRSSI"), benchReadRSSI, BENCH_RUNS);
+    bench(F("screenDraw"), benchScreenDraw, BENCH_RUNS);
+    bench(F("screenUpdate"), benchScreenUpdate, BENCH_RUNS);
+    bench(F("numFormat"), benchNumFormat, BENCH_RUNS);
+    bench(F("printDigits"), benchPrintDigits, BENCH_RUNS);
+#ifdef USE_RSSI_FILTER
+    bench(F("filterMean"), benchFilterMean, BENCH_RUNS);
+    bench(F("filterMedian"), benchFilterMedian, BENCH_RUNS);
+    bench(F("filterTrimmed"), benchFilterTrimmed, BENCH_RUNS);
+#endif
+    bench(F("EEPROM.write"), benchEEPROMWrite, BENCH_EEPROM_RUNS);
+
+    Serial.println(F("BENCH_END"));
+    Serial.flush();
+#ifdef BENCH_TIMER1
+    TIMSK1 = 0;
+    TCCR1B = 0;
+#endif
+}
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Benchmarks by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef bench_h
+#define bench_h
+
+// Benchmarks
+// Runs the hot paths of the firmware BENCH_RUNS times each and reports
+// the cycles per call over serial, tools/bench_compare.py compares the
+// reports of two builds.
+//
+//   BENCH_BEGIN <timer> <F_CPU>
+//   BENCH <name> <runs> <min> <mean> <max>
+//   BENCH_END
+//
+// Timer1 counts every cycle. TV out needs Timer1 for the sync, with TV
+// out the cycles come from micros() and are only exact to 64 cycles.
+// Interrupts stay enabled, the min is the cost without interruptions.
+
+void benchmarkRun();
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * Fast boot by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+
+#ifdef USE_FAST_BOOT
+#include "boot.h"
+
+static unsigned long boot_hold_until = 0;
+
+void bootDelay(uint16_t ms) {
+    unsigned long now = millis();
+    if(!bootHolding()) {
+        boot_hold_until = now;
+    }
+    boot_hold_until += ms;
+}
+
+bool bootHolding() {
+    if(boot_hold_until && (long)(millis() - boot_hold_until) >= 0) {
+        boot_hold_until = 0; // over, millis() may wrap later on
+    }
+    return boot_hold_until != 0;
+}
+#endif
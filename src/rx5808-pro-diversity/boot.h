@@ -0,0 +1,45 @@
+/*
+ * Fast boot by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef boot_h
+#define boot_h
+
+#include <stdint.h>
+#include "settings.h"
+
+// Fast boot
+// The saved channel and the receiver are set up before the display, the
+// waits of the boot screens only keep the boot screen up. loop() keeps
+// the diversity going until the boot screen time is over.
+
+#ifdef USE_FAST_BOOT
+void bootDelay(uint16_t ms); // adds to the time the boot screen is kept
+bool bootHolding(); // true while the boot screen is kept
+#else
+#define bootDelay(ms) delay(ms)
+#endif
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Buttons by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+#include "buttons.h"
+#ifdef USE_SLEEP
+#include "power.h"
+#endif
+
+#define BUTTON_COUNT 4
+#define BUTTON_QUEUE 8 // power of two
+
+static const uint8_t button_pins[BUTTON_COUNT] = { buttonUp, buttonMode, buttonDown, buttonSave };
+
+static volatile uint8_t button_debounce = 0; // ms until the pins are read
+static volatile uint8_t button_state = 0; // debounced, bit per button, 1 is pressed
+static uint16_t button_hold[BUTTON_COUNT]; // ms held, up to the long press
+static uint16_t button_repeat_in[BUTTON_COUNT]; // ms to the next repeat
+static uint8_t button_repeat[BUTTON_COUNT]; // ms between repeats, shrinks while held
+static volatile uint8_t button_queue[BUTTON_QUEUE];
+static volatile uint8_t button_head = 0; // written by the tick only
+static volatile uint8_t button_tail = 0; // written by the main loop only
+
+static void buttonPost(uint8_t event) {
+    uint8_t next = (button_head + 1) & (BUTTON_QUEUE-1);
+    if(next != button_tail) { // dropped when full
+        button_queue[button_head] = event;
+        button_head = next;
+    }
+}
+
+static uint8_t buttonPins() {
+    uint8_t pressed = 0;
+    for(uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        if(digitalRead(button_pins[i]) == LOW) {
+            pressed |= 1 << i;
+        }
+    }
+    return pressed;
+}
+
+void buttonsBegin() {
+    button_state = buttonPins(); // a button held at power up is no press
+    for(uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        *digitalPinToPCMSK(button_pins[i]) |= _BV(digitalPinToPCMSKbit(button_pins[i]));
+        PCICR |= _BV(digitalPinToPCICRbit(button_pins[i]));
+    }
+    // compare A of the millis timer ticks every 1.024ms
+    OCR0A = 0x80;
+    TIMSK0 |= _BV(OCIE0A);
+}
+
+ISR(PCINT0_vect) {
+    button_debounce = BUTTON_DEBOUNCE_TIME; // again after every bounce
+}
+ISR(PCINT1_vect, ISR_ALIASOF(PCINT0_vect));
+ISR(PCINT2_vect, ISR_ALIASOF(PCINT0_vect));
+
+ISR(TIMER0_COMPA_vect) {
+    if(button_debounce && !--button_debounce) {
+        uint8_t pressed = buttonPins();
+        uint8_t changed = pressed ^ button_state;
+        button_state = pressed;
+        for(uint8_t i = 0; i < BUTTON_COUNT; i++) {
+            if(changed & (1 << i)) {
+                button_hold[i] = 0;
+                button_repeat_in[i] = BUTTON_REPEAT_DELAY;
+                button_repeat[i] = BUTTON_REPEAT_TIME;
+                buttonPost(((pressed & (1 << i)) ? BUTTON_PRESS : BUTTON_RELEASE) | (i+1));
+            }
+        }
+    }
+    if(!button_state) {
+        return;
+    }
+    for(uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        if(button_state & (1 << i)) {
+            if(button_hold[i] < BUTTON_LONG_TIME && ++button_hold[i] == BUTTON_LONG_TIME) {
+                buttonPost(BUTTON_LONG | (i+1));
+            }
+            if(!--button_repeat_in[i]) {
+                // not queued behind other events, a slow loop would go on
+                // stepping after the release otherwise.
+                if(button_head == button_tail) {
+                    buttonPost(BUTTON_REPEAT | (i+1));
+                }
+                button_repeat_in[i] = button_repeat[i];
+                // every repeat a quarter faster
+                button_repeat[i] -= button_repeat[i] / 4;
+                if(button_repeat[i] < BUTTON_REPEAT_MIN) {
+                    button_repeat[i] = BUTTON_REPEAT_MIN;
+                }
+            }
+        }
+    }
+}
+
+uint8_t buttonEvent() {
+    if(button_tail == button_head) {
+        return BUTTON_NONE;
+    }
+    uint8_t event = button_queue[button_tail];
+    button_tail = (button_tail + 1) & (BUTTON_QUEUE-1);
+    return event;
+}
+
+uint8_t buttonWait(uint16_t timeout) {
+    unsigned long start = millis();
+    for(;;) {
+        uint8_t event = buttonEvent();
+        if(buttonType(event) == BUTTON_PRESS || buttonType(event) == BUTTON_REPEAT) {
+            return event;
+        }
+        if(event != BUTTON_NONE) {
+            continue; // releases and long presses
+        }
+        if(millis() - start >= timeout) {
+            return BUTTON_NONE;
+        }
+#ifdef USE_SLEEP
+        cli();
+        if(button_tail == button_head) {
+            powerSleep(); // the tick wakes us
+        }
+        else {
+            sei();
+        }
+#endif
+    }
+}
+
+bool buttonHeld(uint8_t button) {
+    return button_state & (1 << (button-1));
+}
+
+void buttonsClear() {
+    button_tail = button_head;
+}
@@ -0,0 +1,59 @@
+/*
+ * Buttons by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef buttons_h
+#define buttons_h
+
+#include <stdint.h>
+
+// Buttons
+// A pin change interrupt starts the debounce, a 1ms timer tick checks the
+// pins once they are stable and queues the events for the main loop.
+// Nothing waits for a button to be released.
+
+#define BUTTON_NONE 0
+#define BUTTON_UP 1
+#define BUTTON_MODE 2
+#define BUTTON_DOWN 3
+#define BUTTON_SAVE 4
+
+// event types, or'ed with the button
+#define BUTTON_PRESS 0x10
+#define BUTTON_RELEASE 0x20
+#define BUTTON_LONG 0x30   // held for BUTTON_LONG_TIME
+#define BUTTON_REPEAT 0x40 // held longer than BUTTON_REPEAT_DELAY, faster and faster
+
+#define buttonId(event) ((event) & 0x0F)
+#define buttonType(event) ((event) & 0xF0)
+
+void buttonsBegin();
+uint8_t buttonEvent(); // next event of any type or BUTTON_NONE
+// next press or repeat, BUTTON_NONE after timeout ms. 0 does not wait.
+uint8_t buttonWait(uint16_t timeout);
+bool buttonHeld(uint8_t button); // debounced state
+void buttonsClear(); // drops the queued events
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * Channel tables by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef channels_h
+#define channels_h
+
+#include <avr/pgmspace.h>
+#include "settings.h"
+
+// Channel tables, indexed by channel index 0 to CHANNEL_MAX_INDEX.
+extern const uint16_t channelTable[] PROGMEM; // SPI register values
+extern const uint16_t channelFreqTable[] PROGMEM; // MHz
+extern const uint8_t channelNames[] PROGMEM; // band in the high nibble, 0xA1 is A1
+// channel indexes ordered by frequency, CHANNEL_MIN to CHANNEL_MAX
+extern const uint8_t channelList[] PROGMEM;
+
+#endif
@@ -0,0 +1,308 @@
+/*
+ * Display list for page based displays by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "settings.h"
+
+#ifdef OLED_128x64_SSD1306_SCREENS
+#include <Arduino.h>
+#include "displaylist.h"
+#include "numfmt.h"
+#include "widgets.h"
+#include <fontALL.h>
+
+#define LIST_NONE 0
+#define LIST_BOX 1
+#define LIST_FRAME 2
+#define LIST_TEXT 3
+#define LIST_TEXT_RAM 4
+#define LIST_NUMBER 5
+#define LIST_GRAPH 6
+#define LIST_BITMAP 7
+
+#define FONT_WIDTH 6
+#define FONT_HEIGHT 8
+
+struct listItem {
+    uint8_t type;
+    uint8_t x, y, w, h;
+    uint8_t style; // color and text style, bar width for graphs
+    uint8_t size; // text size, bar step in half pixels for graphs
+    union {
+        const void *data;
+        uint16_t number;
+    };
+};
+
+static listItem *list = NULL;
+static uint8_t list_length = 0;
+
+// on the heap so builds with a second display only pay for the one in use.
+bool listBegin() {
+    if(!list) {
+        list = (listItem *)malloc(LIST_SIZE * sizeof(listItem));
+    }
+    list_length = 0;
+    return list != NULL;
+}
+
+void listClear() {
+    list_length = 0;
+}
+
+static uint8_t listAdd(uint8_t type, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style, uint8_t size) {
+    if(list_length >= LIST_SIZE) {
+        return LIST_FULL;
+    }
+    listItem *item = &list[list_length];
+    item->type = type;
+    item->x = x;
+    item->y = y;
+    item->w = w;
+    item->h = h;
+    item->style = style;
+    item->size = size;
+    item->data = NULL;
+    return list_length++;
+}
+
+uint8_t listBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    return listAdd(LIST_BOX, x, y, w, h, color, 0);
+}
+
+uint8_t listFrame(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    return listAdd(LIST_FRAME, x, y, w, h, color, 0);
+}
+
+uint8_t listText(uint8_t x, uint8_t y, const char *text, uint8_t color, uint8_t size) {
+    uint8_t handle = listAdd(LIST_TEXT, x, y, strlen_P(text)*FONT_WIDTH*size, FONT_HEIGHT*size, color, size);
+    if(handle != LIST_FULL) {
+        list[handle].data = text;
+    }
+    return handle;
+}
+
+uint8_t listTextRam(uint8_t x, uint8_t y, const char *text, uint8_t length, uint8_t color, uint8_t size) {
+    uint8_t handle = listAdd(LIST_TEXT_RAM, x, y, length*FONT_WIDTH*size, FONT_HEIGHT*size, color, size);
+    if(handle != LIST_FULL) {
+        list[handle].data = text;
+    }
+    return handle;
+}
+
+uint8_t listNumber(uint8_t x, uint8_t y, uint16_t number, uint8_t style, uint8_t size) {
+    // room for 5 digits and the decimal point
+    uint8_t handle = listAdd(LIST_NUMBER, x, y, 6*FONT_WIDTH*size, FONT_HEIGHT*size, style, size);
+    if(handle != LIST_FULL) {
+        list[handle].number = number;
+    }
+    return handle;
+}
+
+uint8_t listGraph(uint8_t x, uint8_t y, uint8_t h, uint8_t bar_width, uint8_t half_step, const uint8_t *values, uint8_t count) {
+    uint8_t handle = listAdd(LIST_GRAPH, x, y, count, h, bar_width, half_step);
+    if(handle != LIST_FULL) {
+        list[handle].data = values;
+    }
+    return handle;
+}
+
+uint8_t listBitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *bitmap, uint8_t color) {
+    uint8_t handle = listAdd(LIST_BITMAP, x, y, w, h, color, 0);
+    if(handle != LIST_FULL) {
+        list[handle].data = bitmap;
+    }
+    return handle;
+}
+
+void listInvalidate(uint8_t handle) {
+    if(handle < list_length) {
+        listItem *item = &list[handle];
+        uint8_t w = item->w;
+        if(item->type == LIST_GRAPH) {
+            // w is the bar count, the columns end with the last bar.
+            w = w ? (w-1)*item->size/2 + item->style : 0;
+        }
+        widgetInvalidate(item->x, item->y, w, item->h);
+    }
+}
+
+bool listUpdate(uint8_t handle, uint16_t number) {
+    if(handle >= list_length || list[handle].type != LIST_NUMBER || list[handle].number == number) {
+        return false;
+    }
+    list[handle].number = number;
+    listInvalidate(handle);
+    return true;
+}
+
+void listMove(uint8_t handle, uint8_t x, uint8_t y) {
+    if(handle >= list_length || (list[handle].x == x && list[handle].y == y)) {
+        return;
+    }
+    listInvalidate(handle);
+    list[handle].x = x;
+    list[handle].y = y;
+    listInvalidate(handle);
+}
+
+bool listStyle(uint8_t handle, uint8_t style) {
+    if(handle >= list_length || list[handle].style == style) {
+        return false;
+    }
+    list[handle].style = style;
+    listInvalidate(handle);
+    return true;
+}
+
+uint8_t pageMask(uint8_t y0, uint8_t y1) {
+    if(y1 > 63) {
+        y1 = 63;
+    }
+    return (0xFF << (y0 / PAGE_HEIGHT)) & (0xFF >> (7 - y1 / PAGE_HEIGHT));
+}
+
+// bits of the page covered by rows y to y+h-1
+static uint8_t rowBits(uint8_t page, uint8_t y, uint8_t h) {
+    int8_t top = y - page*PAGE_HEIGHT;
+    int8_t bottom = top + h;
+    if(bottom <= 0 || top >= PAGE_HEIGHT) {
+        return 0;
+    }
+    uint8_t bits = 0xFF;
+    if(top > 0) {
+        bits <<= top;
+    }
+    if(bottom < PAGE_HEIGHT) {
+        bits &= 0xFF >> (PAGE_HEIGHT - bottom);
+    }
+    return bits;
+}
+
+static void pageColumns(uint8_t *buffer, uint8_t x, uint8_t w, uint8_t bits, uint8_t color) {
+    if(x >= PAGE_WIDTH) {
+        return;
+    }
+    if(w > PAGE_WIDTH - x) {
+        w = PAGE_WIDTH - x;
+    }
+    uint8_t *column = buffer + x;
+    while(w--) {
+        switch(color) {
+            case LIST_WHITE: *column |= bits; break;
+            case LIST_BLACK: *column &= ~bits; break;
+            case LIST_INVERT: *column ^= bits; break;
+        }
+        column++;
+    }
+}
+
+void pageFill(uint8_t *buffer, uint8_t page, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    uint8_t bits = rowBits(page, y, h);
+    if(bits) {
+        pageColumns(buffer, x, w, bits, color);
+    }
+}
+
+void pageText(uint8_t *buffer, uint8_t page, uint8_t x, uint8_t y, const char *text, uint8_t length, bool progmem, uint8_t color, uint8_t size) {
+    uint8_t row0 = page*PAGE_HEIGHT;
+    if(!rowBits(page, y, FONT_HEIGHT*size)) {
+        return;
+    }
+    for(uint8_t i = 0; i < length; i++, x += FONT_WIDTH*size) {
+        char c = progmem ? pgm_read_byte(text+i) : text[i];
+        if(!c || x >= PAGE_WIDTH) {
+            return;
+        }
+        if(c < ' ' || c > '~') {
+            c = ' ';
+        }
+        const unsigned char *glyph = font6x8 + 3 + (c - ' ')*FONT_HEIGHT;
+        // one font row after the other, only the rows inside the page
+        for(uint8_t row = row0 > y ? row0 : y; row < row0+PAGE_HEIGHT && row < y+FONT_HEIGHT*size; row++) {
+            uint8_t line = pgm_read_byte(glyph + (row - y)/size);
+            uint8_t bit = 1 << (row - row0);
+            for(uint8_t col = 0; line; col++, line <<= 1) {
+                if(line & 0x80) {
+                    pageColumns(buffer, x + col*size, size, bit, color);
+                }
+            }
+        }
+    }
+}
+
+static void pageBitmap(uint8_t *buffer, uint8_t page, listItem *item) {
+    uint8_t row0 = page*PAGE_HEIGHT;
+    const uint8_t *bitmap = (const uint8_t *)item->data;
+    for(uint8_t row = row0 > item->y ? row0 : item->y; row < row0+PAGE_HEIGHT && row < item->y+item->h; row++) {
+        uint8_t line = pgm_read_byte(bitmap + row - item->y);
+        for(uint8_t col = 0; col < item->w; col++, line <<= 1) {
+            if(line & 0x80) {
+                pageColumns(buffer, item->x + col, 1, 1 << (row - row0), item->style & (LIST_WHITE|LIST_INVERT));
+            }
+        }
+    }
+}
+
+void listRender(uint8_t *buffer, uint8_t page) {
+    char text[NUM_SIZE];
+    for(listItem *item = list; item < list + list_length; item++) {
+        uint8_t color = item->style & (LIST_WHITE|LIST_INVERT);
+        if((item->style & LIST_HIDDEN) || !rowBits(page, item->y, item->h)) {
+            continue;
+        }
+        switch(item->type) {
+            case LIST_BOX:
+                pageFill(buffer, page, item->x, item->y, item->w, item->h, color);
+                break;
+            case LIST_FRAME:
+                pageFill(buffer, page, item->x, item->y, item->w, 1, color);
+                pageFill(buffer, page, item->x, item->y+item->h-1, item->w, 1, color);
+                pageFill(buffer, page, item->x, item->y, 1, item->h, color);
+                pageFill(buffer, page, item->x+item->w-1, item->y, 1, item->h, color);
+                break;
+            case LIST_TEXT:
+            case LIST_TEXT_RAM:
+                pageText(buffer, page, item->x, item->y, (const char *)item->data, item->w/(FONT_WIDTH*item->size), item->type == LIST_TEXT, color, item->size);
+                break;
+            case LIST_NUMBER:
+                // the number styles are the same bits
+                pageText(buffer, page, item->x, item->y, text, numFormat(text, item->number, item->style & (NUM_HEX|NUM_DECIMAL)), false, color, item->size);
+                break;
+            case LIST_GRAPH: {
+                const uint8_t *values = (const uint8_t *)item->data;
+                for(uint8_t i = 0; i < item->w; i++) {
+                    uint8_t value = values[i] > item->h ? item->h : values[i];
+                    pageFill(buffer, page, item->x + i*item->size/2, item->y + item->h - value, item->style, value, LIST_WHITE);
+                }
+                break;
+            }
+            case LIST_BITMAP:
+                pageBitmap(buffer, page, item);
+                break;
+        }
+    }
+}
+#endif
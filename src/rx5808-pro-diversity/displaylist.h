@@ -0,0 +1,77 @@
+/*
+ * Display list for page based displays by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef displaylist_h
+#define displaylist_h
+
+#include <avr/pgmspace.h>
+
+// Display list
+// Displays without a frame buffer keep the static part of a screen as a
+// list of primitives. The list is drawn again for every 8 row page that
+// is sent to the display, a page is 128 bytes with one bit per row.
+
+#define LIST_SIZE 24 // primitives per screen
+#define PAGE_WIDTH 128
+#define PAGE_HEIGHT 8
+
+#define LIST_BLACK 0
+#define LIST_WHITE 1
+#define LIST_INVERT 2
+
+// text style, the color goes in the lower bits
+#define LIST_HEX     0x04 // numbers printed as hex
+#define LIST_DECIMAL 0x08 // numbers are in tenths, printed with one decimal
+#define LIST_HIDDEN  0x80 // kept in the list but not drawn
+
+// primitives, all return a handle for listUpdate() or LIST_FULL.
+#define LIST_FULL 0xFF
+bool listBegin(); // allocates the list, false if out of memory
+void listClear();
+uint8_t listBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color);
+uint8_t listFrame(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color);
+uint8_t listText(uint8_t x, uint8_t y, const char *text, uint8_t color, uint8_t size = 1); // PROGMEM text
+uint8_t listTextRam(uint8_t x, uint8_t y, const char *text, uint8_t length, uint8_t color, uint8_t size = 1); // text must stay in RAM while shown
+uint8_t listNumber(uint8_t x, uint8_t y, uint16_t number, uint8_t style, uint8_t size = 1);
+uint8_t listGraph(uint8_t x, uint8_t y, uint8_t h, uint8_t bar_width, uint8_t half_step, const uint8_t *values, uint8_t count); // bars growing up from y+h, half_step apart in half pixels
+uint8_t listBitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *bitmap, uint8_t color); // PROGMEM, one byte per row, msb left
+
+// change a number or the style of a primitive, marks its rows for redraw.
+bool listUpdate(uint8_t handle, uint16_t number);
+bool listStyle(uint8_t handle, uint8_t style);
+void listMove(uint8_t handle, uint8_t x, uint8_t y);
+// marks the rows of a primitive for redraw, for graphs and RAM texts.
+void listInvalidate(uint8_t handle);
+
+// draw the whole list into the page buffer.
+void listRender(uint8_t *buffer, uint8_t page);
+
+// drawing into one page, anything outside of the page is clipped.
+void pageFill(uint8_t *buffer, uint8_t page, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color);
+void pageText(uint8_t *buffer, uint8_t page, uint8_t x, uint8_t y, const char *text, uint8_t length, bool progmem, uint8_t color, uint8_t size);
+uint8_t pageMask(uint8_t y0, uint8_t y1); // bit mask of the pages covering rows y0 to y1
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Hardware probe by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+#include "hardware.h"
+#include "adc.h"
+#include "screens.h" // isTVOut() for VBAT_PIN
+
+#define HW_RSSI_MIN 5  // adc steps, an open rssi input reads 0
+#define HW_VBAT_MIN 50 // adc steps, about 0.6V of battery
+
+uint8_t hw_flags = 0;
+
+// the probes that can change while running
+static uint8_t hwPlugged() {
+    uint8_t flags = 0;
+#ifdef USE_DIVERSITY
+    if(adcRead(rssiPinB) >= HW_RSSI_MIN) {
+        flags |= HW_DIVERSITY;
+    }
+#endif
+#ifdef USE_VOLTAGE_MONITORING
+    if(adcRead(VBAT_PIN) >= HW_VBAT_MIN) {
+        flags |= HW_VBAT;
+    }
+#endif
+    return flags;
+}
+
+void hwProbe() {
+    static const uint8_t pins[] = { buttonUp, buttonMode, buttonDown, buttonSave };
+    uint8_t flags = hwPlugged();
+    for(uint8_t i = 0; i < sizeof(pins); i++) {
+        if(digitalRead(pins[i]) == LOW) {
+            flags |= HW_HELD_UP << i;
+        }
+    }
+    hw_flags = flags;
+}
+
+#ifdef USE_HW_REPROBE
+bool hwLoop() {
+    static unsigned long last_probe = 0;
+    if(millis() - last_probe < HW_REPROBE_TIME) {
+        return false;
+    }
+    last_probe = millis();
+    uint8_t flags = (hw_flags & ~(HW_DIVERSITY|HW_VBAT)) | hwPlugged();
+    if(flags == hw_flags) {
+        return false;
+    }
+    hw_flags = flags;
+    return true;
+}
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Hardware probe by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef hardware_h
+#define hardware_h
+
+#include <stdint.h>
+#include "settings.h"
+
+// Hardware probe
+// What is connected is probed once at boot and kept in hw_flags, the
+// screens and the loop test the flags instead of reading the pins again.
+// With USE_HW_REPROBE the receiver B and the battery are probed again
+// every HW_REPROBE_TIME so they can be plugged in while running.
+
+#define HW_DIVERSITY 0x01 // receiver B rssi is connected
+#define HW_VBAT 0x02      // the battery divider gives a voltage
+// buttons held at power up
+#define HW_HELD_UP 0x10
+#define HW_HELD_MODE 0x20
+#define HW_HELD_DOWN 0x40
+#define HW_HELD_SAVE 0x80
+
+extern uint8_t hw_flags;
+#define hwHas(flag) (hw_flags & (flag))
+
+#ifdef USE_DIVERSITY
+    // used to figure out if diversity module has been plugged in.
+    // When RSSI is plugged in the min value is around 90
+    // When RSSI is not plugged in the min value is 0
+    #define isDiversity() hwHas(HW_DIVERSITY)
+#endif
+
+// probes everything, VBAT_PIN depends on the display on AUTO_SCREENS
+// receivers so it is called again after the display is set up there.
+void hwProbe();
+#ifdef USE_HW_REPROBE
+// probes again every HW_REPROBE_TIME, true when the flags changed.
+bool hwLoop();
+#endif
+
+#endif
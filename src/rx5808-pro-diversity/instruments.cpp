@@ -0,0 +1,148 @@
+/*
+ * Instruments by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+
+#ifdef USE_INSTRUMENTS
+#include "instruments.h"
+
+#define STACK_PAINT 0xC5
+
+extern uint8_t __heap_start;
+extern char *__brkval;
+
+unsigned long instr_start[INSTR_SECTIONS];
+uint16_t instr_counts[INSTR_COUNTERS];
+uint16_t instr_time[INSTR_SECTIONS];
+uint16_t instr_rate[INSTR_COUNTERS];
+uint16_t instr_free_ram = 0;
+uint16_t instr_boot[INSTR_MILESTONES];
+
+// sums of the running second
+static unsigned long instr_sum[INSTR_SECTIONS];
+static uint16_t instr_calls[INSTR_SECTIONS];
+static uint16_t instr_max[INSTR_SECTIONS];
+static unsigned long instr_report_time = 0;
+static bool instr_boot_sent = false;
+
+// paints the ram between heap and stack before main() runs, the bytes
+// still painted later were never used by either.
+void instrumentsPaint() __attribute__((naked, used, section(".init3")));
+void instrumentsPaint() {
+    for(uint8_t *p = &__heap_start; p < (uint8_t *)SP; p++) {
+        *p = STACK_PAINT;
+    }
+}
+
+static uint16_t freeRam() {
+    uint8_t *p = __brkval ? (uint8_t *)__brkval : &__heap_start;
+    uint16_t free = 0;
+    for(; p < (uint8_t *)SP && *p == STACK_PAINT; p++) {
+        free++;
+    }
+    return free;
+}
+
+void instrumentsEnd(uint8_t section) {
+    unsigned long time = micros() - instr_start[section];
+    instr_sum[section] += time;
+    instr_calls[section]++;
+    if(time > instr_max[section]) {
+        instr_max[section] = time > 0xFFFF ? 0xFFFF : time;
+    }
+}
+
+static void printSection(const __FlashStringHelper *name, uint8_t section) {
+    Serial.print(name);
+    Serial.print(instr_time[section]);
+    Serial.print('/');
+    Serial.print(instr_max[section]);
+    Serial.print(F("us "));
+}
+
+// BOOT TUNE 2 RX 31 SET 33 DISP 160 READY 162 MENU 1412 ms
+static void printBoot() {
+    static const char names[] PROGMEM = "TUNE\0RX\0SET\0DISP\0READY\0MENU";
+    const char *name = names;
+    Serial.print(F("BOOT"));
+    for(uint8_t i = 0; i < INSTR_MILESTONES; i++) {
+        Serial.print(' ');
+        Serial.print((const __FlashStringHelper *)name);
+        Serial.print(' ');
+        Serial.print(instr_boot[i]);
+        name += strlen_P(name) + 1;
+    }
+    Serial.println(F(" ms"));
+}
+
+bool instrumentsLoop() {
+    instr_counts[INSTR_LOOPS]++;
+    if(!instr_boot_sent && instr_boot[INSTR_BOOT_MENU]) {
+        printBoot();
+        instr_boot_sent = true;
+    }
+    unsigned long elapsed = millis() - instr_report_time;
+    if(elapsed < 1000) {
+        return false;
+    }
+    for(uint8_t i = 0; i < INSTR_COUNTERS; i++) {
+        instr_rate[i] = instr_counts[i] * 1000UL / elapsed;
+        instr_counts[i] = 0;
+    }
+    for(uint8_t i = 0; i < INSTR_SECTIONS; i++) {
+        instr_time[i] = instr_calls[i] ? instr_sum[i] / instr_calls[i] : 0;
+    }
+    instr_free_ram = freeRam();
+
+    // LOOP 480/s ADC 7700/s SW 0/s RSSI 850/912us ... SEEK 2100/2400us ... RAM 410
+    Serial.print(F("LOOP "));
+    Serial.print(instr_rate[INSTR_LOOPS]);
+    Serial.print(F("/s ADC "));
+    Serial.print(instr_rate[INSTR_ADC_READS]);
+    Serial.print(F("/s SW "));
+    Serial.print(instr_rate[INSTR_SWITCHES]);
+    Serial.print(F("/s "));
+    printSection(F("RSSI "), INSTR_RSSI);
+    printSection(F("TUNE "), INSTR_TUNE);
+    printSection(F("EEPROM "), INSTR_EEPROM);
+    printSection(F("SEEK "), INSTR_DRAW_SEEK);
+    printSection(F("SCAN "), INSTR_DRAW_SCAN);
+    printSection(F("SAVER "), INSTR_DRAW_SAVER);
+    printSection(F("DIV "), INSTR_DRAW_DIVERSITY);
+    printSection(F("INSTR "), INSTR_DRAW_INSTRUMENTS);
+    Serial.print(F("RAM "));
+    Serial.println(instr_free_ram);
+
+    for(uint8_t i = 0; i < INSTR_SECTIONS; i++) {
+        instr_sum[i] = 0;
+        instr_calls[i] = 0;
+        instr_max[i] = 0;
+    }
+    instr_report_time += elapsed;
+    return true;
+}
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Instruments by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef instruments_h
+#define instruments_h
+
+#include <stdint.h>
+#include "settings.h"
+
+// Instruments
+// Sections of the loop are timed with micros() between INSTR_BEGIN and
+// INSTR_END, events are counted with INSTR_COUNT. Once a second the
+// average time per call and the counts are taken over as the results and
+// sent over serial, the boot milestones once after the boot. Without USE_INSTRUMENTS the macros are empty.
+
+// timed sections
+#define INSTR_RSSI 0   // readRSSI()
+#define INSTR_TUNE 1   // setChannelModule()
+#define INSTR_EEPROM 2 // settings writes
+// screen updates, one per screens update method
+#define INSTR_DRAW_SEEK 3        // updateSeekMode()
+#define INSTR_DRAW_SCAN 4        // updateBandScanMode()
+#define INSTR_DRAW_SAVER 5       // updateScreenSaver()
+#define INSTR_DRAW_DIVERSITY 6   // updateDiversity()
+#define INSTR_DRAW_INSTRUMENTS 7 // updateInstruments()
+#define INSTR_SECTIONS 8
+
+// counted events
+#define INSTR_LOOPS 0
+#define INSTR_ADC_READS 1
+#define INSTR_SWITCHES 2 // diversity receiver changes
+#define INSTR_COUNTERS 3
+
+// boot milestones, ms after reset
+#define INSTR_BOOT_TUNED 0    // saved channel tuned
+#define INSTR_BOOT_RECEIVER 1 // receiver selected
+#define INSTR_BOOT_SETTINGS 2 // settings read
+#define INSTR_BOOT_DISPLAY 3  // boot screen shown
+#define INSTR_BOOT_READY 4    // end of setup
+#define INSTR_BOOT_MENU 5     // first screen after the boot screen
+#define INSTR_MILESTONES 6
+
+#ifdef USE_INSTRUMENTS
+extern unsigned long instr_start[INSTR_SECTIONS];
+extern uint16_t instr_counts[INSTR_COUNTERS];
+
+// results of the last second
+extern uint16_t instr_time[INSTR_SECTIONS]; // average us per call
+extern uint16_t instr_rate[INSTR_COUNTERS]; // per second
+extern uint16_t instr_free_ram; // bytes between heap and stack never used
+extern uint16_t instr_boot[INSTR_MILESTONES];
+
+void instrumentsEnd(uint8_t section);
+// counts the loop, true once a second when there are new results.
+bool instrumentsLoop();
+
+#define INSTR_BEGIN(section) instr_start[section] = micros()
+#define INSTR_END(section) instrumentsEnd(section)
+#define INSTR_COUNT(counter) instr_counts[counter]++
+#define INSTR_BOOT(milestone) instr_boot[milestone] = millis()
+// drawing statistics of the widgets and the display backends
+#define INSTR_ADD(statistic, n) statistic += (n)
+#else
+#define INSTR_BEGIN(section)
+#define INSTR_END(section)
+#define INSTR_COUNT(counter)
+#define INSTR_BOOT(milestone)
+#define INSTR_ADD(statistic, n)
+#endif
+
+#endif
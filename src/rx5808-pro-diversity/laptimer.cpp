@@ -0,0 +1,285 @@
+/*
+ * Lap timer by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+#include "adc.h"
+#ifdef USE_SLEEP
+#include "power.h"
+#endif
+
+#ifdef USE_LAP_TIMER
+#include "laptimer.h"
+#include "hardware.h"
+
+// main project
+extern uint16_t rssi_min_a;
+extern uint16_t rssi_max_a;
+#ifdef LAP_SPLIT_RECEIVERS
+extern uint16_t rssi_min_b;
+extern uint16_t rssi_max_b;
+#endif
+void setChannelModule(uint8_t channel, uint8_t select_pin);
+
+struct lapPilot {
+    bool in_gate;
+    uint16_t level; // last sample
+    unsigned long time;
+    uint16_t peak; // strongest sample of the pass and its neighbours
+    unsigned long peak_time;
+    uint16_t before;
+    unsigned long before_time;
+    uint16_t after;
+    unsigned long after_time; // same as peak_time until the sample after the peak
+    unsigned long last_pass; // 0 until the first pass started the race
+};
+
+bool lap_active = false;
+uint8_t lap_count[LAP_PILOTS];
+unsigned long lap_times[LAP_PILOTS][LAP_COUNT];
+uint16_t lap_samples = 0;
+
+static lapPilot pilots[LAP_PILOTS];
+static uint16_t enter_level;
+static uint16_t exit_level;
+
+#if LAP_PILOTS > 1
+// the first LAP_PILOTS channels of the list are timed.
+static const uint8_t pilot_channels[] PROGMEM = { LAP_PILOT_CHANNELS };
+static_assert(sizeof(pilot_channels) >= LAP_PILOTS, "LAP_PILOT_CHANNELS needs a channel per pilot");
+static uint8_t slice = 0; // pilot of receiver A in the next slice
+#else
+// receiver A is sampled by compare B of the millis timer, the main loop
+// only reports the passes and can take as long as it likes.
+#define LAP_QUEUE 4 // power of two
+static uint16_t filtered; // raw ADC << LAP_FILTER_SHIFT
+static uint8_t tick = 0; // ms since the last sample
+static volatile uint16_t tick_samples = 0;
+static volatile unsigned long lap_queue[LAP_QUEUE]; // peak times of the passes
+static volatile uint8_t lap_head = 0; // written by the tick only
+static volatile uint8_t lap_tail = 0; // written by the main loop only
+#endif
+
+void lapTimerStart() {
+    if(lap_active) {
+        return;
+    }
+    lap_active = true;
+    memset(pilots, 0, sizeof(pilots));
+    memset(lap_count, 0, sizeof(lap_count));
+#if LAP_PILOTS > 1
+    // samples are scaled to 1..100 per receiver.
+    enter_level = LAP_ENTER_THRESHOLD;
+    exit_level = LAP_EXIT_THRESHOLD;
+    slice = 0;
+#else
+    // thresholds in raw ADC units, the samples are not scaled.
+    enter_level = rssi_min_a + (uint32_t)(rssi_max_a - rssi_min_a) * LAP_ENTER_THRESHOLD / 100;
+    exit_level = rssi_min_a + (uint32_t)(rssi_max_a - rssi_min_a) * LAP_EXIT_THRESHOLD / 100;
+    filtered = adcRead(rssiPinA) << LAP_FILTER_SHIFT;
+    uint16_t stale;
+    adcCollect(&stale); // the last conversion of the previous race
+    tick = 0;
+    tick_samples = 0;
+    lap_tail = lap_head;
+    OCR0B = 0x40;
+    TIMSK0 |= _BV(OCIE0B);
+#endif
+}
+
+void lapTimerStop() {
+#if LAP_PILOTS == 1
+    TIMSK0 &= ~_BV(OCIE0B);
+#endif
+    lap_active = false;
+}
+
+// vertex of the parabola through the peak and its neighbours.
+static unsigned long peakTime(lapPilot *pilot) {
+    long a = pilot->peak_time - pilot->before_time;
+    long b = pilot->after_time - pilot->peak_time;
+    long p = pilot->peak - pilot->before;
+    long q = pilot->peak - pilot->after;
+    long den = a*q + b*p;
+    if(a <= 0 || b <= 0 || den <= 0 || !pilot->before_time) {
+        return pilot->peak_time;
+    }
+    long offset = (b*b*p - a*a*q) / (2*den);
+    return pilot->peak_time + constrain(offset, -a, b);
+}
+
+static bool gatePassed(uint8_t index, unsigned long time) {
+    lapPilot *pilot = &pilots[index];
+    if(pilot->last_pass && time - pilot->last_pass < LAP_MIN_TIME) {
+        return false; // the same pass seen twice
+    }
+    bool lap = pilot->last_pass != 0;
+#if LAP_PILOTS > 1
+    Serial.print(index+1);
+    Serial.print(' ');
+#endif
+    if(lap) {
+        lap_times[index][lap_count[index] % LAP_COUNT] = time - pilot->last_pass;
+        lap_count[index]++;
+        Serial.print("LAP ");
+        Serial.print(lap_count[index]);
+        Serial.print(' ');
+        Serial.println(time - pilot->last_pass);
+    }
+    else {
+        Serial.println("START");
+    }
+    pilot->last_pass = time;
+    return lap;
+}
+
+// true when the pass ended, peakTime() is the time of the pass.
+static bool pilotSample(uint8_t index, uint16_t level, unsigned long now) {
+    lapPilot *pilot = &pilots[index];
+    bool passed = false;
+    if(!pilot->in_gate) {
+        if(level >= enter_level) {
+            pilot->in_gate = true;
+            pilot->peak = 0;
+        }
+    }
+    if(pilot->in_gate) {
+        if(level > pilot->peak) {
+            pilot->peak = level;
+            pilot->peak_time = pilot->after_time = now;
+            pilot->before = pilot->level;
+            pilot->before_time = pilot->time;
+        }
+        else if(pilot->after_time == pilot->peak_time) {
+            pilot->after = level;
+            pilot->after_time = now;
+        }
+        if(level < exit_level) {
+            pilot->in_gate = false;
+            passed = true;
+        }
+    }
+    pilot->level = level;
+    pilot->time = now;
+    return passed;
+}
+
+#if LAP_PILOTS > 1
+// one round robin step, receiver B takes the next pilot if it is plugged in.
+static bool lapSlice() {
+    uint8_t a = slice;
+    uint8_t step = 1;
+    setChannelModule(pgm_read_byte_near(pilot_channels + a), slaveSelectPin);
+#ifdef LAP_SPLIT_RECEIVERS
+    uint8_t b = (a + 1) % LAP_PILOTS;
+    if(isDiversity()) {
+        setChannelModule(pgm_read_byte_near(pilot_channels + b), slaveSelectPinB);
+        step = 2;
+    }
+    uint16_t sum_b = 0;
+#endif
+    slice = (a + step) % LAP_PILOTS;
+#ifdef USE_SLEEP
+    powerIdle(MIN_TUNE_TIME); // the shortest dwell, the module has to settle
+#else
+    delay(MIN_TUNE_TIME); // the shortest dwell, the module has to settle
+#endif
+
+    uint16_t sum_a = 0;
+    for(uint8_t i=0; i<LAP_SLICE_READS; i++) {
+        sum_a += adcRead(rssiPinA);
+#ifdef LAP_SPLIT_RECEIVERS
+        if(step == 2) {
+            sum_b += adcRead(rssiPinB);
+        }
+#endif
+    }
+    unsigned long now = millis();
+    bool lap = false;
+    lap_samples++;
+    if(pilotSample(a, constrain(map(sum_a/LAP_SLICE_READS, rssi_min_a, rssi_max_a, 1, 100), 1, 100), now)) {
+        lap = gatePassed(a, peakTime(&pilots[a]));
+    }
+#ifdef LAP_SPLIT_RECEIVERS
+    if(step == 2) {
+        lap_samples++;
+        if(pilotSample(b, constrain(map(sum_b/LAP_SLICE_READS, rssi_min_b, rssi_max_b, 1, 100), 1, 100), now)) {
+            lap |= gatePassed(b, peakTime(&pilots[b]));
+        }
+    }
+#endif
+    return lap;
+}
+#else
+ISR(TIMER0_COMPB_vect) {
+    uint16_t value;
+    if(++tick < LAP_SAMPLE_TICKS - 1) {
+        return;
+    }
+    if(!adcCollect(&value)) {
+        // converts until the next tick, a busy ADC is tried again then
+        adcStart(rssiPinA);
+        return;
+    }
+    tick = 0;
+    tick_samples++;
+    // a short running average, the gate pass lasts much longer.
+    filtered += value - (filtered >> LAP_FILTER_SHIFT);
+    if(pilotSample(0, filtered >> LAP_FILTER_SHIFT, millis())) {
+        uint8_t next = (lap_head + 1) & (LAP_QUEUE-1);
+        if(next != lap_tail) { // dropped when full
+            lap_queue[lap_head] = peakTime(&pilots[0]);
+            lap_head = next;
+        }
+    }
+}
+#endif
+
+bool lapTimerRun(uint8_t time) {
+    bool lap = false;
+    if(!lap_active) {
+        return false;
+    }
+#if LAP_PILOTS > 1
+    unsigned long start = millis();
+    lap_samples = 0;
+    do {
+        lap |= lapSlice();
+    } while(millis() - start < time);
+#else
+    uint8_t sreg = SREG;
+    cli();
+    lap_samples = tick_samples;
+    tick_samples = 0;
+    SREG = sreg;
+    while(lap_tail != lap_head) {
+        lap |= gatePassed(0, lap_queue[lap_tail]);
+        lap_tail = (lap_tail + 1) & (LAP_QUEUE-1);
+    }
+#endif
+    return lap;
+}
+#endif
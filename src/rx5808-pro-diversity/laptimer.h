@@ -0,0 +1,54 @@
+/*
+ * Lap timer by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef laptimer_h
+#define laptimer_h
+
+#include <stdint.h>
+
+// Lap timer
+// Samples the RSSI of receiver A every LAP_SAMPLE_TICKS ms from the timer
+// tick and looks for the peak of every pass through the gate. A pass starts
+// when the RSSI rises above the enter threshold and ends when it falls
+// below the exit threshold, the pass is timed at its strongest sample.
+// With more than one pilot the receivers are time sliced over the pilot
+// channels, every pilot is only seen once per round. The peak time is then
+// interpolated from the strongest sample and its two neighbours.
+
+#define LAP_COUNT (32/LAP_PILOTS) // laps kept in RAM per pilot
+
+extern bool lap_active;
+extern uint8_t lap_count[]; // completed laps per pilot since the start
+extern unsigned long lap_times[][LAP_COUNT]; // ms, lap_count-1 is the newest (modulo LAP_COUNT)
+extern uint16_t lap_samples; // samples since the previous lapTimerRun()
+
+void lapTimerStart(); // arm the timer with the current calibration
+void lapTimerStop(); // receivers have to be tuned to the watched channel again
+// reports the passes of the tick, more than one pilot is sampled here for
+// the given time. Returns true if a lap was completed.
+bool lapTimerRun(uint8_t time);
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Number formatting by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <avr/pgmspace.h>
+#include "numfmt.h"
+
+static const uint16_t powers[] PROGMEM = { 10000, 1000, 100, 10 };
+
+uint8_t numFormat(char *text, uint16_t number, uint8_t style, uint8_t width) {
+    char digits[NUM_SIZE];
+    uint8_t length = 0;
+    if(style & NUM_HEX) {
+        for(uint8_t i = 0; i < 4; i++, number <<= 4) {
+            uint8_t nibble = number >> 12;
+            if(nibble || length || i == 3) {
+                digits[length++] = nibble < 10 ? '0' + nibble : 'A' + nibble - 10;
+            }
+        }
+    }
+    else {
+        for(uint8_t i = 0; i < 4; i++) {
+            uint16_t power = pgm_read_word(powers + i);
+            char digit = '0';
+            while(number >= power) {
+                number -= power;
+                digit++;
+            }
+            if(digit != '0' || length || ((style & NUM_DECIMAL) && i == 3)) {
+                digits[length++] = digit; // tenths always get their units
+            }
+        }
+        if(style & NUM_DECIMAL) {
+            digits[length++] = '.';
+        }
+        digits[length++] = '0' + number;
+    }
+
+    if(width > NUM_SIZE - 1) {
+        width = NUM_SIZE - 1;
+    }
+    char pad = (style & NUM_ZEROS) ? '0' : ' ';
+    uint8_t i = 0;
+    for(; i + length < width; i++) {
+        text[i] = pad;
+    }
+    for(uint8_t d = 0; d < length; d++) {
+        text[i++] = digits[d];
+    }
+    text[i] = '\0';
+    return i;
+}
@@ -0,0 +1,48 @@
+/*
+ * Number formatting by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef numfmt_h
+#define numfmt_h
+
+#include <stdint.h>
+
+// Number formatting
+// The numbers on the screens are turned into text here instead of by
+// Print, which divides a 32 bit number for every digit. The decimal
+// digits are counted by subtracting powers of ten, hex digits are nibbles.
+
+// style bits, the same as the WIDGET_ and LIST_ number styles
+#define NUM_HEX 0x04     // printed as hex
+#define NUM_DECIMAL 0x08 // in tenths, printed with one decimal
+#define NUM_ZEROS 0x40   // padded with zeros instead of spaces
+
+#define NUM_SIZE 8 // buffer for any number and width, with the terminator
+
+// writes the terminated text to text, right aligned in width characters
+// if width is not 0. Returns the length without the terminator.
+uint8_t numFormat(char *text, uint16_t number, uint8_t style, uint8_t width = 0);
+
+#endif
@@ -0,0 +1,812 @@
+/*
+ * SSD1306 display list screens by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+    SSD1306 and SH1106 screens without a frame buffer.
+
+    The static part of a screen is kept as a display list, the widgets are
+    drawn on top of it. Every page of 8 rows is drawn into a 128 byte
+    buffer and sent over I2C before the next one is drawn, pages that have
+    not changed are not drawn or sent at all.
+
+    Every page also remembers the columns that have changed, only those
+    are sent. The SH1106 has no horizontal addressing mode and 132 columns
+    of which the middle 128 are visible, it is written the same way with
+    the column address moved by 2.
+*/
+
+#include "settings.h"
+
+#ifdef OLED_128x64_SSD1306_SCREENS
+#include "screens.h" // function headers
+#include "widgets.h"
+#include "boot.h"
+#include "hardware.h"
+#include "displaylist.h"
+#include "trace.h"
+#include "instruments.h"
+#include <Arduino.h>
+#include <Wire.h>
+
+typedef screens_t<DISPLAY_OLED_SSD1306> ssd1306Screens;
+
+#define BLACK LIST_BLACK
+#define WHITE LIST_WHITE
+#define INVERT LIST_INVERT
+
+#define DISPLAY_WIDTH 128
+#define DISPLAY_HEIGHT 64
+#define DISPLAY_PAGES 8
+#define ALL_PAGES 0xFF
+#define SSD1306_ADDRESS 0x3C
+
+#ifdef SH1106
+    #define COLUMN_OFFSET 2
+#else
+    #define COLUMN_OFFSET 0
+#endif
+
+static uint8_t *page_buffer = NULL; // allocated by begin()
+static uint8_t *spectrum = NULL; // rssi per channel for the spectrum graphs
+static uint8_t page = 0; // page being drawn
+static bool rendering = false;
+// changed columns of every page, clean pages have dirty_from > dirty_to.
+static uint8_t dirty_from[DISPLAY_PAGES];
+static uint8_t dirty_to[DISPLAY_PAGES];
+static bool flipped = false;
+
+#ifdef USE_INSTRUMENTS
+// page statistics
+uint16_t ssd1306_page_renders = 0;
+uint16_t ssd1306_page_skips = 0;
+uint16_t ssd1306_column_writes = 0;
+#endif
+
+static const uint8_t init_commands[] PROGMEM = {
+    0xAE,       // display off
+    0xD5, 0x80, // clock divide ratio
+    0xA8, 0x3F, // multiplex 64
+    0xD3, 0x00, // display offset
+    0x40,       // start line 0
+#ifdef SH1106
+    0xAD, 0x8B, // dc-dc on, always page addressing
+#else
+    0x8D, 0x14, // charge pump on
+    0x20, 0x02, // page addressing
+#endif
+    0xDA, 0x12, // com pins
+    0x81, 0xCF, // contrast
+    0xD9, 0xF1, // precharge
+    0xDB, 0x40, // vcom detect
+    0xA4,       // show ram content
+    0xA6,       // not inverted
+    0xAF        // display on
+};
+
+static void sendCommand(uint8_t command) {
+    Wire.beginTransmission(SSD1306_ADDRESS);
+    Wire.write(0x00); // command
+    Wire.write(command);
+    Wire.endTransmission();
+}
+
+// send columns from to to of the page buffer.
+static void sendPage(uint8_t from, uint8_t to) {
+    uint8_t column = from + COLUMN_OFFSET;
+    Wire.beginTransmission(SSD1306_ADDRESS);
+    Wire.write(0x00); // commands
+    Wire.write(0xB0 | page);
+    Wire.write(column & 0x0F);
+    Wire.write(0x10 | (column >> 4));
+    Wire.endTransmission();
+    // the Wire buffer is 32 bytes, send the columns in 16 byte pieces
+    for(uint8_t i=from; i<=to; i+=16) {
+        Wire.beginTransmission(SSD1306_ADDRESS);
+        Wire.write(0x40); // data
+        for(uint8_t j=i; j<=to && j<i+16; j++) {
+            Wire.write(page_buffer[j]);
+        }
+        Wire.endTransmission();
+    }
+    INSTR_ADD(ssd1306_column_writes, to - from + 1);
+}
+
+static void clearColumns(uint8_t index) {
+    dirty_from[index] = PAGE_WIDTH-1;
+    dirty_to[index] = 0;
+}
+
+static void markColumns(uint8_t pages, uint8_t from, uint8_t to) {
+    for(uint8_t i=0; i<DISPLAY_PAGES; i++) {
+        if(pages & (1 << i)) {
+            dirty_from[i] = min(dirty_from[i], from);
+            dirty_to[i] = max(dirty_to[i], to);
+        }
+    }
+}
+
+static void render() {
+#ifdef USE_TRACE
+    unsigned long start = millis();
+    bool sent = false;
+#endif
+    rendering = true;
+    for(page=0; page<DISPLAY_PAGES; page++) {
+        if(dirty_from[page] > dirty_to[page]) {
+            INSTR_ADD(ssd1306_page_skips, 1);
+            continue;
+        }
+        memset(page_buffer, 0, PAGE_WIDTH);
+        listRender(page_buffer, page);
+        for(uint8_t i=0; i<WIDGET_COUNT; i++) {
+            widgets[i].draw();
+        }
+        sendPage(dirty_from[page], dirty_to[page]);
+        INSTR_ADD(ssd1306_page_renders, 1);
+#ifdef USE_TRACE
+        sent = true;
+#endif
+        clearColumns(page);
+    }
+    rendering = false;
+#ifdef USE_TRACE
+    if(sent) {
+        unsigned long time = millis() - start;
+        TRACE(TRACE_FLUSH, 1, time > 255 ? 255 : time);
+    }
+#endif
+}
+
+static void show() {
+    markColumns(ALL_PAGES, 0, PAGE_WIDTH-1);
+    render();
+}
+
+template<> void widgetHooks<DISPLAY_OLED_SSD1306>::fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    if(rendering) {
+        pageFill(page_buffer, page, x, y, w, h, color);
+    }
+}
+
+template<> void widgetHooks<DISPLAY_OLED_SSD1306>::drawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    if(rendering && w && h) {
+        pageFill(page_buffer, page, x, y, w, 1, color);
+        pageFill(page_buffer, page, x, y+h-1, w, 1, color);
+        pageFill(page_buffer, page, x, y, 1, h, color);
+        pageFill(page_buffer, page, x+w-1, y, 1, h, color);
+    }
+}
+
+template<> void widgetHooks<DISPLAY_OLED_SSD1306>::text(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const char *text, uint8_t style) {
+    // pages start out blank, an empty text has nothing to clear.
+    if(!rendering || (!text[0] && !(style & WIDGET_INVERT))) {
+        return;
+    }
+    uint8_t color = (style & WIDGET_INVERT) ? BLACK : WHITE;
+    pageFill(page_buffer, page, x, y, w, h, !color);
+    if((style & WIDGET_CENTER) && strlen(text)*6 < w) {
+        x += (w - strlen(text)*6) / 2;
+    }
+    pageText(page_buffer, page, x, y + (h - 8 + 1) / 2, text, strlen(text), false, color, 1);
+}
+
+template<> void widgetHooks<DISPLAY_OLED_SSD1306>::invalidate(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    if(!rendering && w && h && x < DISPLAY_WIDTH) {
+        markColumns(pageMask(y, y+h-1), x, min(x+w-1, DISPLAY_WIDTH-1));
+    }
+}
+
+template<> ssd1306Screens::screens_t() {
+    last_channel = -1;
+    last_rssi = 0;
+}
+
+template<> void ssd1306Screens::reset() {
+    widgetsReset();
+    listClear();
+}
+
+template<> void ssd1306Screens::flip() {
+    // the controller can draw rotated, pages stay where they are.
+    flipped = !flipped;
+    sendCommand(flipped ? 0xA0 : 0xA1); // segment remap
+    sendCommand(flipped ? 0xC0 : 0xC8); // com scan direction
+}
+
+template<> char ssd1306Screens::begin(const char *call_sign) {
+    page_buffer = (uint8_t *)malloc(PAGE_WIDTH);
+    spectrum = (uint8_t *)malloc(CHANNEL_MAX_INDEX+1);
+    if(!page_buffer || !spectrum || !listBegin()) {
+        return 1; // out of memory
+    }
+    for(uint8_t i=0; i<DISPLAY_PAGES; i++) {
+        clearColumns(i);
+    }
+    Wire.begin();
+    TWBR = 12; // 400kHz I2C
+    for(uint8_t i=0; i<sizeof(init_commands); i++) {
+        sendCommand(pgm_read_byte(init_commands+i));
+    }
+    flipped = false;
+#ifdef USE_FLIP_SCREEN
+    flip();
+#else
+    sendCommand(0xA1); // segment remap
+    sendCommand(0xC8); // com scan direction
+#endif
+    reset();
+
+    listBox(0, 0, DISPLAY_WIDTH, 11, WHITE);
+    listText(((DISPLAY_WIDTH - (10*6)) / 2), 2, PSTR("Boot Check"), BLACK);
+    listText(0, 8*1+4, PSTR("Power:"), WHITE);
+    listText(DISPLAY_WIDTH-6*2, 8*1+4, PSTR("OK"), WHITE);
+#ifdef USE_DIVERSITY
+    listText(0, 8*2+4, PSTR("Diversity:"), WHITE);
+    show();
+    bootDelay(250);
+    if(isDiversity()) {
+        listText(DISPLAY_WIDTH-6*8, 8*2+4, PSTR(" ENABLED"), WHITE);
+    }
+    else {
+        listText(DISPLAY_WIDTH-6*8, 8*2+4, PSTR("DISABLED"), WHITE);
+    }
+#endif
+    uint8_t length = strnlen(call_sign, 10);
+    listTextRam(((DISPLAY_WIDTH - (length*12)) / 2), 8*4+4, call_sign, length, WHITE, 2);
+    show();
+    bootDelay(1250);
+    return 0; // no errors
+}
+
+template<> void ssd1306Screens::drawTitleBox(const char *title) {
+    listFrame(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, WHITE);
+    listBox(0, 0, DISPLAY_WIDTH, 11, WHITE);
+    // center text
+    listText(((DISPLAY_WIDTH - (strlen_P(title)*6)) / 2), 2, title, BLACK);
+}
+
+static const uint8_t bottom_triangle[] PROGMEM = { 0xF8, 0x70, 0x20 };
+static const uint8_t top_triangle[] PROGMEM = { 0x20, 0x70, 0xF8 };
+
+template<> void ssd1306Screens::drawBottomTriangle(bool color){
+    listBitmap(120, 58, 5, 3, bottom_triangle, color);
+}
+
+template<> void ssd1306Screens::drawTopTriangle(bool color){
+    listBitmap(120, 12, 5, 3, top_triangle, color);
+}
+
+template<> void ssd1306Screens::mainMenu(uint8_t menu_id) {
+    reset(); // start from fresh screen.
+    drawTitleBox(PSTR("MODE SELECTION"));
+
+    listBox(0, 10*menu_id+12, DISPLAY_WIDTH, 10, WHITE);
+
+    listText(5, 10*0+13, PSTR("AUTO SEARCH"), menu_id == 0 ? BLACK : WHITE);
+    listText(5, 10*1+13, PSTR("BAND SCANNER"), menu_id == 1 ? BLACK : WHITE);
+    listText(5, 10*2+13, PSTR("MANUAL MODE"), menu_id == 2 ? BLACK : WHITE);
+#ifdef USE_DIVERSITY
+    if(isDiversity())
+    {
+        listText(5, 10*3+13, PSTR("DIVERSITY"), menu_id == 3 ? BLACK : WHITE);
+    }
+#endif
+    listText(5, 10*4+13, PSTR("SETUP MENU"), menu_id == 4 ? BLACK : WHITE);
+    show();
+}
+
+static uint8_t spectrum_graph;
+static uint8_t scan_cursor;
+#ifdef USE_LBAND
+    #define SPECTRUM_X(channel) ((channel)*5/2+4)
+    #define SPECTRUM_BAR_WIDTH 2
+    #define SPECTRUM_HALF_STEP 5
+#else
+    #define SPECTRUM_X(channel) ((channel)*3+4)
+    #define SPECTRUM_BAR_WIDTH 3
+    #define SPECTRUM_HALF_STEP 6
+#endif
+
+// frequency scale and spectrum graph of the seek and scan screens
+static void drawSpectrum(uint8_t height) {
+    listBox(0, DISPLAY_HEIGHT-11, DISPLAY_WIDTH, 1, WHITE);
+#ifdef USE_LBAND
+    listText(2, DISPLAY_HEIGHT-9, PSTR("5362"), WHITE);
+#else
+    listText(2, DISPLAY_HEIGHT-9, PSTR("5645"), WHITE);
+#endif
+    listText(55, DISPLAY_HEIGHT-9, PSTR("5800"), WHITE);
+    listText(DISPLAY_WIDTH-25, DISPLAY_HEIGHT-9, PSTR("5945"), WHITE);
+
+    memset(spectrum, 0, CHANNEL_MAX_INDEX+1);
+    spectrum_graph = listGraph(4, DISPLAY_HEIGHT-12-height, height, SPECTRUM_BAR_WIDTH, SPECTRUM_HALF_STEP, spectrum, CHANNEL_MAX_INDEX+1);
+    // scan position, a black line drawn over the graph
+    scan_cursor = listBox(0, DISPLAY_HEIGHT-12-height, 1, height, BLACK | LIST_HIDDEN);
+}
+
+static void updateSpectrum(uint8_t channel, uint8_t rssi_scaled) {
+    if(spectrum[channel] != rssi_scaled) {
+        spectrum[channel] = rssi_scaled;
+        listInvalidate(spectrum_graph);
+    }
+}
+
+template<> void ssd1306Screens::seekMode(uint8_t state) {
+    last_channel = -1;
+    reset(); // start from fresh screen.
+    if (state == STATE_MANUAL)
+    {
+        drawTitleBox(PSTR("MANUAL MODE"));
+    }
+    else if(state == STATE_SEEK)
+    {
+        drawTitleBox(PSTR("AUTO SEEK MODE"));
+    }
+    listBox(0, 20, DISPLAY_WIDTH, 1, WHITE);
+    listBox(0, 32, DISPLAY_WIDTH, 1, WHITE);
+    listBox(97, 11, 1, 10, WHITE);
+    listText(5, 12, PSTR("BAND:"), WHITE);
+    listBox(0, 36, DISPLAY_WIDTH, 1, WHITE);
+    drawSpectrum(14);
+
+    widgets[WIDGET_SEEK_TITLE].label(((DISPLAY_WIDTH-14*6)/2), 2, 14*6, 8, 0);
+    widgets[WIDGET_SEEK_BAND].label(36, 12, 9*6, 8, 0);
+    widgets[WIDGET_SEEK_CHANNELS].list(4, 21, 14, 11, 15, channelItems, CHANNEL_BAND_SIZE, WIDGET_CENTER);
+    widgets[WIDGET_SEEK_FREQUENCY].number(101, 12, 4*6, 8, 0);
+    widgets[WIDGET_SEEK_RSSI].bar(1, 33, DISPLAY_WIDTH-3, 3, 0);
+    widgets[WIDGET_SEEK_THRESHOLD_LEFT].marker(1, DISPLAY_HEIGHT-12-14, 2, 1, WIDGET_VERTICAL);
+    widgets[WIDGET_SEEK_THRESHOLD_RIGHT].marker(DISPLAY_WIDTH-3, DISPLAY_HEIGHT-12-14, 3, 1, WIDGET_VERTICAL);
+    show();
+}
+
+template<> void ssd1306Screens::updateSeekMode(uint8_t state, uint8_t channelIndex, uint8_t channel, uint8_t rssi, uint16_t channelFrequency, uint8_t rssi_seek_threshold, bool locked) {
+    // display refresh handler
+    if(channel != last_channel && state == STATE_SEEK) // only updated on changes
+    {
+        // Show Scan Position
+        listMove(scan_cursor, SPECTRUM_X(channel) + (channel > last_channel ? 3 : -1), DISPLAY_HEIGHT-12-14);
+        listStyle(scan_cursor, BLACK);
+    }
+    // show current used channel of bank
+    const char *band;
+#ifdef USE_LBAND
+    if(channelIndex > 39)
+    {
+        band = PSTR("D/5.3");
+    }
+    else if(channelIndex > 31)
+#else
+    if(channelIndex > 31)
+#endif
+    {
+        band = PSTR("C/Race");
+    }
+    else if(channelIndex > 23)
+    {
+        band = PSTR("F/Airwave");
+    }
+    else if (channelIndex > 15)
+    {
+        band = PSTR("E");
+    }
+    else if (channelIndex > 7)
+    {
+        band = PSTR("B");
+    }
+    else
+    {
+        band = PSTR("A");
+    }
+    widgets[WIDGET_SEEK_BAND].update(band);
+    widgets[WIDGET_SEEK_CHANNELS].update(channelIndex%CHANNEL_BAND_SIZE); // get channel inside band
+    // show frequence
+    widgets[WIDGET_SEEK_FREQUENCY].update(channelFrequency);
+
+    // show signal strength
+    widgets[WIDGET_SEEK_RSSI].update(map(rssi, 1, 100, 1, DISPLAY_WIDTH-3));
+
+    uint8_t rssi_scaled=map(rssi, 1, 100, 1, 14);
+    updateSpectrum(channel, rssi_scaled);
+
+    // handling for seek mode after screen and RSSI has been fully processed
+    if(state == STATE_SEEK) //
+    { // SEEK MODE
+        uint8_t threshold_scaled=map(rssi_seek_threshold, 1, 100, 1, 14);
+
+        widgets[WIDGET_SEEK_THRESHOLD_LEFT].update(14-threshold_scaled);
+        widgets[WIDGET_SEEK_THRESHOLD_RIGHT].update(14-threshold_scaled);
+
+        if(locked) // search if not found
+        {
+            widgets[WIDGET_SEEK_TITLE].update(PSTR("AUTO MODE LOCK"), WIDGET_INVERT);
+        }
+        else
+        {
+            widgets[WIDGET_SEEK_TITLE].update(PSTR("AUTO SEEK MODE"), WIDGET_INVERT);
+        }
+    }
+
+    last_channel = channel;
+    last_rssi = rssi_scaled;
+    render();
+}
+
+#ifdef USE_SCOUT
+template<> void ssd1306Screens::updateScout(uint8_t channel, uint8_t rssi) {
+    // drawn with the next updateSeekMode()
+    updateSpectrum(channel, map(rssi, 1, 100, 1, 14));
+}
+#endif
+
+template<> void ssd1306Screens::bandScanMode(uint8_t state) {
+    reset(); // start from fresh screen.
+    best_rssi = 0;
+    if(state==STATE_SCAN)
+    {
+        drawTitleBox(PSTR("BAND SCANNER"));
+        listText(5, 12, PSTR("BEST:"), WHITE);
+    }
+    else
+    {
+        drawTitleBox(PSTR("RSSI SETUP"));
+        listText(5, 12, PSTR("Min:     Max:"), WHITE);
+    }
+    listBox(0, 20, DISPLAY_WIDTH, 1, WHITE);
+    drawSpectrum(30);
+
+    widgets[WIDGET_SCAN_NAME].number(36, 12, 2*6, 8, WIDGET_HEX);
+    widgets[WIDGET_SCAN_FREQUENCY].number(52, 12, 4*6, 8, 0);
+    widgets[WIDGET_SCAN_MIN].number(30, 12, 3*6, 8, 0);
+    widgets[WIDGET_SCAN_MAX].number(85, 12, 3*6, 8, 0);
+    show();
+}
+
+template<> void ssd1306Screens::updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, uint8_t channelName, uint16_t channelFrequency, uint16_t rssi_setup_min_a, uint16_t rssi_setup_max_a) {
+    uint8_t rssi_scaled=map(rssi, 1, 100, 1, 30);
+    if(channel != last_channel) // only updated on changes
+    {
+        updateSpectrum(channel, rssi_scaled);
+        // Show Scan Position
+        listMove(scan_cursor, SPECTRUM_X(channel)+3, DISPLAY_HEIGHT-12-30);
+        listStyle(scan_cursor, BLACK);
+    }
+    if(!in_setup) {
+        if (rssi > RSSI_SEEK_TRESHOLD) {
+            if(best_rssi < rssi) {
+                best_rssi = rssi;
+                widgets[WIDGET_SCAN_NAME].update(channelName);
+                widgets[WIDGET_SCAN_FREQUENCY].update(channelFrequency);
+            }
+        }
+    }
+    else {
+        widgets[WIDGET_SCAN_MIN].update(rssi_setup_min_a);
+        widgets[WIDGET_SCAN_MAX].update(rssi_setup_max_a);
+    }
+    render();
+    last_channel = channel;
+}
+
+#ifdef USE_VOLTAGE_MONITORING
+static uint8_t voltage_number;
+#endif
+#ifdef USE_DIVERSITY
+static bool screensaver_diversity;
+#endif
+
+template<> void ssd1306Screens::screenSaver(uint8_t diversity_mode, uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
+    reset();
+    listNumber(0, 0, channelName, WHITE | LIST_HEX, 6);
+    listTextRam(70, 0, call_sign, strnlen(call_sign, 10), WHITE);
+    listNumber(70, 28, channelFrequency, WHITE, 2);
+#ifdef USE_VOLTAGE_MONITORING
+    voltage_number = listNumber(70, 9, 0, WHITE | LIST_DECIMAL | LIST_HIDDEN);
+#endif
+#ifdef USE_DIVERSITY
+    screensaver_diversity = isDiversity();
+    if(screensaver_diversity) {
+        switch(diversity_mode) {
+            case useReceiverAuto:
+                listText(70, 18, PSTR("AUTO"), WHITE);
+                break;
+            case useReceiverA:
+                listText(70, 18, PSTR("ANTENNA A"), WHITE);
+                break;
+            case useReceiverB:
+                listText(70, 18, PSTR("ANTENNA B"), WHITE);
+                break;
+        }
+        listBox(0, DISPLAY_HEIGHT-19, 7, 9, WHITE);
+        listText(1, DISPLAY_HEIGHT-18, PSTR("A"), BLACK);
+        listBox(0, DISPLAY_HEIGHT-9, 7, 9, WHITE);
+        listText(1, DISPLAY_HEIGHT-8, PSTR("B"), BLACK);
+
+        widgets[WIDGET_RSSI_A].bar(7, DISPLAY_HEIGHT-19, 119, 9, 0);
+        widgets[WIDGET_RSSI_B].bar(7, DISPLAY_HEIGHT-9, 119, 9, 0);
+    }
+    else
+#endif
+    {
+        listBox(0, DISPLAY_HEIGHT-19, 25, 19, WHITE);
+        listText(1, DISPLAY_HEIGHT-13, PSTR("RSSI"), BLACK);
+        widgets[WIDGET_RSSI].bar(25, DISPLAY_HEIGHT-19, 101, 19, 0);
+    }
+    widgets[WIDGET_LOW_SIGNAL].label(50, DISPLAY_HEIGHT-13, 10*6, 8, 0);
+    show();
+}
+
+template<> void ssd1306Screens::screenSaver(uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
+    screenSaver(-1, channelName, channelFrequency, call_sign);
+}
+
+template<> void ssd1306Screens::updateScreenSaver(char active_receiver, uint8_t rssi, uint8_t rssiA, uint8_t rssiB) {
+#ifdef USE_DIVERSITY
+    if(screensaver_diversity) {
+        #define RSSI_BAR_SIZE 119
+        widgets[WIDGET_RSSI_A].update(map(rssiA, 1, 100, 3, RSSI_BAR_SIZE), active_receiver == useReceiverA ? 0 : WIDGET_OUTLINE);
+        widgets[WIDGET_RSSI_B].update(map(rssiB, 1, 100, 3, RSSI_BAR_SIZE), active_receiver == useReceiverB ? 0 : WIDGET_OUTLINE);
+        #undef RSSI_BAR_SIZE
+    }
+    else
+#endif
+    {
+        #define RSSI_BAR_SIZE 101
+        widgets[WIDGET_RSSI].update(map(rssi, 1, 100, 1, RSSI_BAR_SIZE));
+        #undef RSSI_BAR_SIZE
+    }
+    // every page is drawn from scratch, the warning leaves nothing behind.
+    widgets[WIDGET_LOW_SIGNAL].update((rssi < 20 && millis()%250 < 125) ? PSTR("LOW SIGNAL") : NULL);
+    render();
+}
+
+template<> void ssd1306Screens::updateScreenSaver(uint8_t rssi) {
+    updateScreenSaver(-1, rssi, -1, -1);
+}
+
+#ifdef USE_VOLTAGE_MONITORING
+template<> void ssd1306Screens::updateVoltageScreenSaver(int voltage, bool alarm){
+    bool visible = !alarm || millis()%250 < 125;
+    listUpdate(voltage_number, voltage);
+    listStyle(voltage_number, WHITE | LIST_DECIMAL | (visible ? 0 : LIST_HIDDEN));
+    render();
+}
+#endif
+
+#ifdef USE_DIVERSITY
+template<> void ssd1306Screens::diversity(uint8_t diversity_mode) {
+    reset();
+    drawTitleBox(PSTR("DIVERSITY"));
+
+    //selected
+    listBox(0, 10*diversity_mode+12, DISPLAY_WIDTH, 10, WHITE);
+
+    listText(5, 10*1+3, PSTR("AUTO"), diversity_mode == useReceiverAuto ? BLACK : WHITE);
+    listText(5, 10*2+3, PSTR("RECEIVER A"), diversity_mode == useReceiverA ? BLACK : WHITE);
+    listText(5, 10*3+3, PSTR("RECEIVER B"), diversity_mode == useReceiverB ? BLACK : WHITE);
+
+    // RSSI Strength
+    listFrame(0, DISPLAY_HEIGHT-21, DISPLAY_WIDTH, 11, WHITE);
+    listText(5, DISPLAY_HEIGHT-19, PSTR("A:"), WHITE);
+    listText(5, DISPLAY_HEIGHT-9, PSTR("B:"), WHITE);
+
+    widgets[WIDGET_RSSI_A].bar(18, DISPLAY_HEIGHT-19, 108, 7, 0);
+    widgets[WIDGET_RSSI_B].bar(18, DISPLAY_HEIGHT-9, 108, 7, 0);
+    show();
+}
+
+template<> void ssd1306Screens::updateDiversity(char active_receiver, uint8_t rssiA, uint8_t rssiB){
+    #define RSSI_BAR_SIZE 108
+    widgets[WIDGET_RSSI_A].update(map(rssiA, 1, 100, 1, RSSI_BAR_SIZE), active_receiver == useReceiverA ? 0 : WIDGET_OUTLINE);
+    widgets[WIDGET_RSSI_B].update(map(rssiB, 1, 100, 1, RSSI_BAR_SIZE), active_receiver == useReceiverB ? 0 : WIDGET_OUTLINE);
+    #undef RSSI_BAR_SIZE
+    render();
+}
+#endif
+
+#ifdef USE_VOLTAGE_MONITORING
+template<> void ssd1306Screens::voltage(uint8_t menu_id, int voltage_calibration, uint8_t warning_voltage, uint8_t critical_voltage) {
+    reset();
+    drawTitleBox(PSTR("VOLTAGE ALARM"));
+
+    listBox(0, 10*menu_id+12, DISPLAY_WIDTH, 10, WHITE);
+
+    listText(5, 10*1+3, PSTR("Warning:"), menu_id == 0 ? BLACK : WHITE);
+    listNumber(80, 10*1+3, warning_voltage, (menu_id == 0 ? BLACK : WHITE) | LIST_DECIMAL);
+    listText(5, 10*2+3, PSTR("Critical:"), menu_id == 1 ? BLACK : WHITE);
+    listNumber(80, 10*2+3, critical_voltage, (menu_id == 1 ? BLACK : WHITE) | LIST_DECIMAL);
+    listText(5, 10*3+3, PSTR("Calibrate:"), menu_id == 2 ? BLACK : WHITE);
+    listNumber(80, 10*3+3, voltage_calibration, menu_id == 2 ? BLACK : WHITE);
+    listText(5, 10*4+3, PSTR("Save"), menu_id == 3 ? BLACK : WHITE);
+
+    listText(5, 10*5+3, PSTR("Measured:"), WHITE);
+    voltage_number = listNumber(80, 10*5+3, 0, WHITE | LIST_DECIMAL);
+    show();
+}
+template<> void ssd1306Screens::updateVoltage(int voltage){
+    listUpdate(voltage_number, voltage);
+    render();
+}
+#endif
+
+template<> void ssd1306Screens::setupMenu(){
+}
+template<> void ssd1306Screens::updateSetupMenu(uint8_t menu_id, bool settings_beeps, bool settings_orderby_channel, const char *call_sign, char editing){
+    reset();
+    drawTitleBox(PSTR("SETUP MENU"));
+    //selected
+    uint8_t selected_position = menu_id % 5;
+    listBox(0, 10*selected_position+12, DISPLAY_WIDTH, 10, WHITE);
+    if(menu_id < 5){
+        drawBottomTriangle(selected_position == 4 ? BLACK : WHITE);
+        listText(5, 10*1+3, PSTR("ORDER: "), selected_position == 0 ? BLACK : WHITE);
+        if(settings_orderby_channel) {
+            listText(5+7*6, 10*1+3, PSTR("CHANNEL"), selected_position == 0 ? BLACK : WHITE);
+        }
+        else {
+            listText(5+7*6, 10*1+3, PSTR("FREQUENCY"), selected_position == 0 ? BLACK : WHITE);
+        }
+
+        listText(5, 10*2+3, PSTR("BEEPS: "), selected_position == 1 ? BLACK : WHITE);
+        if(settings_beeps) {
+            listText(5+7*6, 10*2+3, PSTR("ON"), selected_position == 1 ? BLACK : WHITE);
+        }
+        else {
+            listText(5+7*6, 10*2+3, PSTR("OFF"), selected_position == 1 ? BLACK : WHITE);
+        }
+
+        listText(5, 10*3+3, PSTR("SIGN : "), selected_position == 2 ? BLACK : WHITE);
+        if(editing>=0) {
+            listBox(6*6+5, 10*2+13, DISPLAY_WIDTH-(6*6+6), 8, BLACK);
+            listBox(6*7+6*(editing)+4, 10*2+13, 7, 8, WHITE); //set cursor
+            // inverted text is black on the cursor only
+            listTextRam(5+7*6, 10*3+3, call_sign, 10, INVERT);
+        }
+        else {
+            listTextRam(5+7*6, 10*3+3, call_sign, strnlen(call_sign, 10), selected_position == 2 ? BLACK : WHITE);
+        }
+
+        listText(5, 10*4+3, PSTR("CALIBRATE RSSI"), selected_position == 3 ? BLACK : WHITE);
+
+#ifdef USE_VOLTAGE_MONITORING
+        listText(5, 10*5+3, PSTR("VOLTAGE ALARM"), selected_position == 4 ? BLACK : WHITE);
+    } else {
+        drawTopTriangle(selected_position == 0 ? BLACK : WHITE);
+        listText(5, 10*1+3, PSTR("SAVE & EXIT"), selected_position == 0 ? BLACK : WHITE);
+    }
+#else
+        listText(5, 10*5+3, PSTR("SAVE & EXIT"), selected_position == 4 ? BLACK : WHITE);
+    }
+#endif
+    show();
+}
+
+static uint8_t saved_text;
+
+template<> void ssd1306Screens::save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency, const char *call_sign) {
+    reset();
+    drawTitleBox(PSTR("SAVE SETTINGS"));
+
+    listText(5, 8*1+4, PSTR("MODE:"), WHITE);
+    switch (mode)
+    {
+        case STATE_SCAN: // Band Scanner
+            listText(38, 8*1+4, PSTR("BAND SCANNER"), WHITE);
+        break;
+        case STATE_MANUAL: // manual mode
+            listText(38, 8*1+4, PSTR("MANUAL"), WHITE);
+        break;
+        case STATE_SEEK: // seek mode
+            listText(38, 8*1+4, PSTR("AUTO SEEK"), WHITE);
+        break;
+    }
+
+    listText(5, 8*2+4, PSTR("BAND:"), WHITE);
+    // print band
+    const char *band;
+#ifdef USE_LBAND
+    if(channelIndex > 39)
+    {
+        band = PSTR("D/5.3");
+    }
+    else if(channelIndex > 31)
+#else
+    if(channelIndex > 31)
+#endif
+    {
+        band = PSTR("C/Race");
+    }
+    else if(channelIndex > 23)
+    {
+        band = PSTR("F/Airwave");
+    }
+    else if (channelIndex > 15)
+    {
+        band = PSTR("E");
+    }
+    else if (channelIndex > 7)
+    {
+        band = PSTR("B");
+    }
+    else
+    {
+        band = PSTR("A");
+    }
+    listText(38, 8*2+4, band, WHITE);
+
+    listText(5, 8*3+4, PSTR("CHAN:"), WHITE);
+    listNumber(38, 8*3+4, channelIndex%CHANNEL_BAND_SIZE+1, WHITE); // get channel inside band
+    listText(5, 8*4+4, PSTR("FREQ:     GHz"), WHITE);
+    listNumber(38, 8*4+4, channelFrequency, WHITE);
+
+    listText(5, 8*5+4, PSTR("SIGN:"), WHITE);
+    listTextRam(38, 8*5+4, call_sign, strnlen(call_sign, 10), WHITE);
+
+    saved_text = listText(((DISPLAY_WIDTH-11*6)/2), 8*6+4, PSTR("-- SAVED --"), WHITE);
+    show();
+}
+
+template<> void ssd1306Screens::updateSave(const char * msg) {
+    // the list can not take text back, the new message goes on top
+    listStyle(saved_text, WHITE | LIST_HIDDEN);
+    saved_text = listTextRam(((DISPLAY_WIDTH-strlen(msg)*6)/2), 8*6+4, msg, strlen(msg), WHITE);
+    render();
+}
+
+#ifdef USE_INSTRUMENTS
+static uint8_t instruments_number; // the 8 numbers follow this handle
+
+// rates per second on the left, times in us on the right
+template<> void ssd1306Screens::instruments() {
+    reset();
+    drawTitleBox(PSTR("INSTRUMENTS"));
+    listText(2, 10*1+3, PSTR("LOOP"), WHITE);
+    listText(2, 10*2+3, PSTR("ADC"), WHITE);
+    listText(2, 10*3+3, PSTR("SW"), WHITE);
+    listText(2, 10*4+3, PSTR("RAM"), WHITE);
+    listText(66, 10*1+3, PSTR("RSSI"), WHITE);
+    listText(66, 10*2+3, PSTR("TUNE"), WHITE);
+    listText(66, 10*3+3, PSTR("DRAW"), WHITE);
+    listText(66, 10*4+3, PSTR("EEPR"), WHITE);
+    listText(2, 10*5+3, PSTR("PER SEC"), WHITE);
+    listText(66, 10*5+3, PSTR("TIME US"), WHITE);
+    instruments_number = listNumber(32, 10*1+3, 0, WHITE);
+    for(uint8_t i = 1; i < 8; i++) {
+        listNumber(i < 4 ? 32 : 96, 10*(i%4+1)+3, 0, WHITE);
+    }
+    show();
+}
+
+template<> void ssd1306Screens::updateInstruments(uint16_t loops, uint16_t adc_reads, uint16_t switches, uint16_t free_ram, uint16_t rssi_time, uint16_t tune_time, uint16_t draw_time, uint16_t eeprom_time) {
+    uint16_t values[] = { loops, adc_reads, switches, free_ram, rssi_time, tune_time, draw_time, eeprom_time };
+    if(instruments_number != LIST_FULL) {
+        for(uint8_t i = 0; i < 8; i++) {
+            listUpdate(instruments_number+i, values[i]);
+        }
+    }
+    render();
+}
+#endif
+#endif
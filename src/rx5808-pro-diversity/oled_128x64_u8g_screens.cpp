@@ -1,169 +1,957 @@
-/*
- * u8glib screens by Shea Ivey
-
-The MIT License (MIT)
-
-Copyright (c) 2015 Shea Ivey
-
-Permission is hereby granted, free of charge, to any person obtaining a copy
-of this software and associated documentation files (the "Software"), to deal
-in the Software without restriction, including without limitation the rights
-to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-copies of the Software, and to permit persons to whom the Software is
-furnished to do so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-*/
-
-
-/*
-    The u8glib screens were started and later abandoned due to performance issues.
-    Here for reference should anyone want to take on this task.
-
-    Shea Ivey
-*/
-
-#include "settings.h"
-
-#ifdef OLED_128x64_U8G_SCREENS
-#include "screens.h" // function headers
-#include <U8glib.h>
-
-#define BLACK 0
-#define WHITE 1
-
-
-U8GLIB_SSD1306_128X64 u8g(U8G_I2C_OPT_DEV_0|U8G_I2C_OPT_NO_ACK|U8G_I2C_OPT_FAST);	// Fast I2C / TWI
-
-screens::screens() {
-    reset();
-}
-
-
-char screens::begin() {
-    return 0;
-}
-
-
-void screens::reset() {
-    u8g.setFont(u8g_font_fixed_v0);
-    u8g.setFontRefHeightExtendedText();
-    u8g.setDefaultForegroundColor();
-    u8g.setFontPosTop();
-    u8g.setColorIndex(WHITE);
-}
-
-void screens::flip() {
-    u8g.setRot180();
-}
-
-void screens::drawTitleBox(const char *title) {
-    u8g.setColorIndex(WHITE);
-    u8g.drawFrame(0, 0, u8g.getWidth(), u8g.getHeight());
-    u8g.drawBox(0, 0, u8g.getWidth(), 11);
-    u8g.setColorIndex(BLACK);
-
-    // center text
-    u8g.setPrintPos(((u8g.getWidth() - u8g.getStrWidth(title)) / 2),1);
-    u8g.print(title);
-}
-
-
-void screens::mainMenu(uint8_t menu_id){
-    u8g.firstPage();
-    do {
-        reset(); // start from fresh screen.
-        drawTitleBox("MODE SELECTION");
-        u8g.setColorIndex(WHITE);
-        u8g.drawBox(0, 10*menu_id+12, u8g.getWidth(), 10);
-
-        u8g.setColorIndex(menu_id == 0 ? BLACK : WHITE);
-        u8g.setPrintPos(5,10*0+12);
-        u8g.print("AUTO SEARCH");
-        u8g.setColorIndex(menu_id == 1 ? BLACK : WHITE);
-        u8g.setPrintPos(5,10*1+12);
-        u8g.print("BAND SCANNER");
-        u8g.setColorIndex(menu_id == 2 ? BLACK : WHITE);
-        u8g.setPrintPos(5,10*2+12);
-        u8g.print("MANUAL MODE");
-
-#ifdef USE_DIVERSITY
-        u8g.setColorIndex(menu_id == 3 ? BLACK : WHITE);
-        u8g.setPrintPos(5,10*3+12);
-        u8g.print("DIVERSITY");
-#endif
-        u8g.setColorIndex(menu_id == 4 ? BLACK : WHITE);
-        u8g.setPrintPos(5,10*4+12);
-        u8g.print("SAVE SETUP");
-    } while( u8g.nextPage() );
-}
-
-void screens::seekMode(uint8_t state) {
-    last_channel = -1;
-    reset(); // start from fresh screen.
-}
-
-void screens::updateSeekMode(uint8_t state, uint8_t channelIndex, uint8_t channel, uint8_t rssi, uint16_t channelFrequency, bool locked) {
-
-    last_channel = channel;
-}
-
-void screens::bandScanMode(uint8_t state) {
-    reset(); // start from fresh screen.
-    best_rssi = 0;
-    if(state==STATE_SCAN)
-    {
-        drawTitleBox("BAND SCANNER");
-    }
-    else
-    {
-        drawTitleBox("RSSI SETUP");
-    }
-}
-
-void screens::updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, uint8_t channelName, uint16_t channelFrequency, uint16_t rssi_setup_min_a, uint16_t rssi_setup_max_a) {
-    static uint8_t writePos=SCANNER_LIST_X_POS;
-    last_channel = channel;
-}
-
-void screens::screenSaver(uint8_t channelName, uint16_t channelFrequency) {
-    screenSaver(-1, channelName, channelFrequency);
-}
-void screens::screenSaver(uint8_t diversity_mode, uint8_t channelName, uint16_t channelFrequency) {
-
-}
-
-void screens::updateScreenSaver(uint8_t rssi) {
-    updateScreenSaver(-1, rssi, -1, -1);
-}
-void screens::updateScreenSaver(char active_receiver, uint8_t rssi, uint8_t rssiA, uint8_t rssiB) {
-
-}
-
-#ifdef USE_DIVERSITY
-void screens::diversity(uint8_t diversity_mode) {
-    reset();
-    drawTitleBox("DIVERSITY");
-}
-void screens::updateDiversity(char active_receiver, uint8_t rssiA, uint8_t rssiB){
-
-}
-#endif
-
-void screens::save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency) {
-    reset();
-    drawTitleBox("SAVE SETTINGS");
-}
-
-void screens::updateSave(const char * msg) {
-}
-#endif
+/*
+ * u8glib screens by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+    The u8glib screens run in page mode, only 128 bytes of display memory
+    are needed instead of the 1KB frame buffer of the Adafruit library.
+
+    u8glib can not keep anything on screen between pictures, every page is
+    drawn again from the screen layer (the static part of a screen) and the
+    widgets on top of it. To keep that cheap the widgets only mark the pages
+    they have changed and the picture loop skips every page that is clean.
+*/
+
+#include "settings.h"
+
+#ifdef OLED_128x64_U8G_SCREENS
+#include "screens.h" // function headers
+#include "widgets.h"
+#include "boot.h"
+#include "hardware.h"
+#include "trace.h"
+#include "instruments.h"
+#include <U8glib.h>
+
+typedef screens_t<DISPLAY_OLED_U8G> u8gScreens;
+
+#define BLACK 0
+#define WHITE 1
+
+#define PAGE_HEIGHT 8
+#define ALL_PAGES 0xFF
+
+// draw a PROGMEM string without copying it to RAM first
+#define drawTextP(x, y, s) u8g.drawStrP(x, y, (const u8g_pgm_uint8_t *)PSTR(s))
+
+U8GLIB_SSD1306_128X64 u8g(U8G_I2C_OPT_DEV_0|U8G_I2C_OPT_NO_ACK|U8G_I2C_OPT_FAST);	// Fast I2C / TWI
+
+// static part of the screen in use, drawn first on every page.
+static void (*layer)() = NULL;
+static uint8_t dirty_pages = 0; // one bit per page of 8 rows
+static bool rendering = false;
+static bool flipped = false;
+
+#ifdef USE_INSTRUMENTS
+// picture loop statistics
+uint16_t u8g_page_renders = 0;
+uint16_t u8g_page_skips = 0;
+#endif
+
+// state of the screen in use, the layers draw from here
+static uint8_t shown_id; // menu id, receiver or state
+static uint8_t shown_channel;
+static uint16_t shown_frequency;
+static const char *shown_text;
+static const char *shown_message;
+static bool shown_diversity;
+static bool shown_flag;
+#ifdef USE_VOLTAGE_MONITORING
+static int shown_voltage;
+static uint8_t shown_warning_voltage;
+static uint8_t shown_critical_voltage;
+static int shown_calibration;
+#endif
+#ifdef USE_INSTRUMENTS
+static uint16_t shown_instruments[8];
+#endif
+
+// rssi per channel for the spectrum graphs
+static uint8_t spectrum[CHANNEL_MAX_INDEX+1];
+static uint8_t spectrum_height;
+static char scan_position = 0; // cursor offset to the last channel, 0 for none
+static uint8_t scan_channel = 0;
+#ifdef USE_LBAND
+    #define SPECTRUM_X(channel) ((channel)*5/2+4)
+    #define SPECTRUM_BAR_WIDTH 2
+#else
+    #define SPECTRUM_X(channel) ((channel)*3+4)
+    #define SPECTRUM_BAR_WIDTH 3
+#endif
+
+// bit mask of the pages covering rows y0 to y1
+static uint8_t pageMask(uint8_t y0, uint8_t y1) {
+    if(y1 > 63) {
+        y1 = 63;
+    }
+    return (ALL_PAGES << (y0 / PAGE_HEIGHT)) & (ALL_PAGES >> (7 - y1 / PAGE_HEIGHT));
+}
+
+// page buffer of the display, below the rotation device when flipped.
+static u8g_pb_t *pageBuffer() {
+    u8g_dev_t *dev = u8g.getU8g()->dev;
+    if(flipped) {
+        dev = (u8g_dev_t *)dev->dev_mem;
+    }
+    return (u8g_pb_t *)dev->dev_mem;
+}
+
+static void drawPage() {
+    u8g.setColorIndex(WHITE);
+    if(layer) {
+        layer();
+    }
+    for(uint8_t i=0; i<WIDGET_COUNT; i++) {
+        widgets[i].draw();
+    }
+}
+
+// picture loop, only draws and sends the dirty pages.
+static void render() {
+    if(!dirty_pages) {
+        return;
+    }
+#ifdef USE_TRACE
+    unsigned long start = millis();
+#endif
+    u8g_t *u = u8g.getU8g();
+    u8g_pb_t *pb = pageBuffer();
+    bool more = true;
+    rendering = true;
+    u8g.firstPage();
+    while(more) {
+        if(dirty_pages & pageMask(u->current_page.y0, u->current_page.y1)) {
+            drawPage();
+            INSTR_ADD(u8g_page_renders, 1);
+            more = u8g.nextPage();
+        }
+        else {
+            // the page buffer is still blank, step over the page without sending it
+            INSTR_ADD(u8g_page_skips, 1);
+            more = u8g_page_Next(&pb->p);
+            u8g_GetPageBox(u, &u->current_page);
+        }
+    }
+    rendering = false;
+    dirty_pages = 0;
+#ifdef USE_TRACE
+    unsigned long time = millis() - start;
+    TRACE(TRACE_FLUSH, 1, time > 255 ? 255 : time);
+#endif
+}
+
+static void show(void (*new_layer)()) {
+    layer = new_layer;
+    dirty_pages = ALL_PAGES;
+    render();
+}
+
+template<> void widgetHooks<DISPLAY_OLED_U8G>::fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    if(rendering && w && h) {
+        u8g.setColorIndex(color);
+        u8g.drawBox(x, y, w, h);
+    }
+}
+
+template<> void widgetHooks<DISPLAY_OLED_U8G>::drawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    if(rendering && w && h) {
+        u8g.setColorIndex(color);
+        u8g.drawFrame(x, y, w, h);
+    }
+}
+
+template<> void widgetHooks<DISPLAY_OLED_U8G>::text(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const char *text, uint8_t style) {
+    // pages start out blank, an empty text has nothing to clear.
+    if(!rendering || (!text[0] && !(style & WIDGET_INVERT))) {
+        return;
+    }
+    uint8_t color = (style & WIDGET_INVERT) ? BLACK : WHITE;
+    u8g.setColorIndex(!color);
+    u8g.drawBox(x, y, w, h);
+    if((style & WIDGET_CENTER) && strlen(text)*6 < w) {
+        x += (w - strlen(text)*6) / 2;
+    }
+    u8g.setColorIndex(color);
+    u8g.drawStr(x, y + (h - 7) / 2, text);
+}
+
+template<> void widgetHooks<DISPLAY_OLED_U8G>::invalidate(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    if(!rendering && h) {
+        dirty_pages |= pageMask(y, y+h-1);
+    }
+}
+
+template<> u8gScreens::screens_t() {
+    last_channel = -1;
+    last_rssi = 0;
+}
+
+static void drawBootCheck() {
+    u8g.drawBox(0, 0, u8g.getWidth(), 11);
+    u8g.setColorIndex(BLACK);
+    drawTextP(((u8g.getWidth() - (10*6)) / 2), 2, "Boot Check");
+    u8g.setColorIndex(WHITE);
+    drawTextP(0, 8*1+4, "Power:");
+    drawTextP(u8g.getWidth()-6*2, 8*1+4, "OK");
+#ifdef USE_DIVERSITY
+    if(shown_id > 0) {
+        drawTextP(0, 8*2+4, "Diversity:");
+    }
+    if(shown_id > 1) {
+        if(shown_diversity) {
+            drawTextP(u8g.getWidth()-6*8, 8*2+4, " ENABLED");
+        }
+        else {
+            drawTextP(u8g.getWidth()-6*8, 8*2+4, "DISABLED");
+        }
+    }
+#endif
+    if(shown_id > 2) {
+        u8g.setFont(u8g_font_10x20);
+        u8g.drawStr(((u8g.getWidth() - (strlen(shown_text)*10)) / 2), 8*4+2, shown_text);
+        u8g.setFont(u8g_font_6x10);
+    }
+}
+
+template<> void u8gScreens::reset() {
+    widgetsReset();
+    layer = NULL;
+    u8g.setFont(u8g_font_6x10);
+    u8g.setFontPosTop();
+    u8g.setColorIndex(WHITE);
+}
+
+template<> void u8gScreens::flip() {
+    u8g.setRot180();
+    flipped = true;
+}
+
+template<> char u8gScreens::begin(const char *call_sign) {
+#ifdef USE_FLIP_SCREEN
+    flip();
+#endif
+    reset();
+    shown_text = call_sign;
+    shown_id = 0;
+    show(drawBootCheck);
+#ifdef USE_DIVERSITY
+    shown_id = 1;
+    show(drawBootCheck);
+    bootDelay(250);
+    shown_diversity = isDiversity();
+#endif
+    shown_id = 3;
+    show(drawBootCheck);
+    bootDelay(1250);
+    return 0; // no errors
+}
+
+// the layers are plain functions, the screens helpers forward to these.
+static void titleBox(const char *title) {
+    u8g.setColorIndex(WHITE);
+    u8g.drawFrame(0, 0, u8g.getWidth(), u8g.getHeight());
+    u8g.drawBox(0, 0, u8g.getWidth(), 11);
+    u8g.setColorIndex(BLACK);
+    // center text
+    u8g.drawStrP(((u8g.getWidth() - (strlen_P(title)*6)) / 2), 2, (const u8g_pgm_uint8_t *)title);
+    u8g.setColorIndex(WHITE);
+}
+
+static void bottomTriangle(bool color){
+    u8g.setColorIndex(color);
+    u8g.drawBox(120, 58, 5, 1);
+    u8g.drawBox(121, 59, 3, 1);
+    u8g.drawBox(122, 60, 1, 1);
+}
+
+static void topTriangle(bool color){
+    u8g.setColorIndex(color);
+    u8g.drawBox(120, 14, 5, 1);
+    u8g.drawBox(121, 13, 3, 1);
+    u8g.drawBox(122, 12, 1, 1);
+}
+
+template<> void u8gScreens::drawTitleBox(const char *title) {
+    titleBox(title);
+}
+
+template<> void u8gScreens::drawBottomTriangle(bool color){
+    bottomTriangle(color);
+}
+
+template<> void u8gScreens::drawTopTriangle(bool color){
+    topTriangle(color);
+}
+
+static void drawMainMenu() {
+    uint8_t menu_id = shown_id;
+    titleBox(PSTR("MODE SELECTION"));
+    u8g.drawBox(0, 10*menu_id+12, u8g.getWidth(), 10);
+
+    u8g.setColorIndex(menu_id == 0 ? BLACK : WHITE);
+    drawTextP(5, 10*0+13, "AUTO SEARCH");
+    u8g.setColorIndex(menu_id == 1 ? BLACK : WHITE);
+    drawTextP(5, 10*1+13, "BAND SCANNER");
+    u8g.setColorIndex(menu_id == 2 ? BLACK : WHITE);
+    drawTextP(5, 10*2+13, "MANUAL MODE");
+#ifdef USE_DIVERSITY
+    if(shown_diversity)
+    {
+        u8g.setColorIndex(menu_id == 3 ? BLACK : WHITE);
+        drawTextP(5, 10*3+13, "DIVERSITY");
+    }
+#endif
+    u8g.setColorIndex(menu_id == 4 ? BLACK : WHITE);
+    drawTextP(5, 10*4+13, "SETUP MENU");
+}
+
+template<> void u8gScreens::mainMenu(uint8_t menu_id) {
+    reset(); // start from fresh screen.
+    shown_id = menu_id;
+#ifdef USE_DIVERSITY
+    shown_diversity = isDiversity();
+#endif
+    show(drawMainMenu);
+}
+
+static void drawSpectrum() {
+    u8g.setColorIndex(WHITE);
+    for(uint8_t i=0; i<=CHANNEL_MAX_INDEX; i++) {
+        if(spectrum[i]) {
+            u8g.drawBox(SPECTRUM_X(i), u8g.getHeight()-12-spectrum[i], SPECTRUM_BAR_WIDTH, spectrum[i]);
+        }
+    }
+    if(scan_position) {
+        // show scan position
+        u8g.setColorIndex(BLACK);
+        u8g.drawBox(SPECTRUM_X(scan_channel)+scan_position, u8g.getHeight()-12-spectrum_height, 1, spectrum_height);
+        u8g.setColorIndex(WHITE);
+    }
+}
+
+static void invalidateSpectrum(uint8_t channel) {
+    widgetInvalidate(SPECTRUM_X(channel), u8g.getHeight()-12-spectrum_height, SPECTRUM_BAR_WIDTH, spectrum_height);
+}
+
+static void drawFrequencyScale() {
+    u8g.drawHLine(0, u8g.getHeight()-11, u8g.getWidth());
+#ifdef USE_LBAND
+    drawTextP(2, u8g.getHeight()-9, "5362");
+#else
+    drawTextP(2, u8g.getHeight()-9, "5645");
+#endif
+    drawTextP(55, u8g.getHeight()-9, "5800");
+    drawTextP(u8g.getWidth()-25, u8g.getHeight()-9, "5945");
+}
+
+static void drawSeekMode() {
+    if (shown_id == STATE_MANUAL)
+    {
+        titleBox(PSTR("MANUAL MODE"));
+    }
+    else if(shown_id == STATE_SEEK)
+    {
+        titleBox(PSTR("AUTO SEEK MODE"));
+    }
+    u8g.drawHLine(0, 20, u8g.getWidth());
+    u8g.drawHLine(0, 32, u8g.getWidth());
+    u8g.drawVLine(97, 11, 10);
+    drawTextP(5, 12, "BAND:");
+    u8g.drawHLine(0, 36, u8g.getWidth());
+    drawFrequencyScale();
+    drawSpectrum();
+}
+
+template<> void u8gScreens::seekMode(uint8_t state) {
+    last_channel = -1;
+    reset(); // start from fresh screen.
+    shown_id = state;
+    memset(spectrum, 0, sizeof(spectrum));
+    spectrum_height = 14;
+    scan_position = 0;
+
+    widgets[WIDGET_SEEK_TITLE].label(((u8g.getWidth()-14*6)/2), 2, 14*6, 8, 0);
+    widgets[WIDGET_SEEK_BAND].label(36, 12, 9*6, 8, 0);
+    widgets[WIDGET_SEEK_CHANNELS].list(4, 21, 14, 11, 15, channelItems, CHANNEL_BAND_SIZE, WIDGET_CENTER);
+    widgets[WIDGET_SEEK_FREQUENCY].number(101, 12, 4*6, 8, 0);
+    widgets[WIDGET_SEEK_RSSI].bar(1, 33, u8g.getWidth()-3, 3, 0);
+    widgets[WIDGET_SEEK_THRESHOLD_LEFT].marker(1, u8g.getHeight()-12-14, 2, 1, WIDGET_VERTICAL);
+    widgets[WIDGET_SEEK_THRESHOLD_RIGHT].marker(u8g.getWidth()-3, u8g.getHeight()-12-14, 3, 1, WIDGET_VERTICAL);
+    show(drawSeekMode);
+}
+
+template<> void u8gScreens::updateSeekMode(uint8_t state, uint8_t channelIndex, uint8_t channel, uint8_t rssi, uint16_t channelFrequency, uint8_t rssi_seek_threshold, bool locked) {
+    // display refresh handler
+    if(channel != last_channel) // only updated on changes
+    {
+        if(state == STATE_SEEK) {
+            if(last_channel <= CHANNEL_MAX_INDEX) {
+                invalidateSpectrum(last_channel);
+            }
+            scan_channel = channel;
+            scan_position = channel > last_channel ? 3 : -1;
+        }
+    }
+    // show current used channel of bank
+    const char *band;
+#ifdef USE_LBAND
+    if(channelIndex > 39)
+    {
+        band = PSTR("D/5.3");
+    }
+    else if(channelIndex > 31)
+#else
+    if(channelIndex > 31)
+#endif
+    {
+        band = PSTR("C/Race");
+    }
+    else if(channelIndex > 23)
+    {
+        band = PSTR("F/Airwave");
+    }
+    else if (channelIndex > 15)
+    {
+        band = PSTR("E");
+    }
+    else if (channelIndex > 7)
+    {
+        band = PSTR("B");
+    }
+    else
+    {
+        band = PSTR("A");
+    }
+    widgets[WIDGET_SEEK_BAND].update(band);
+    widgets[WIDGET_SEEK_CHANNELS].update(channelIndex%CHANNEL_BAND_SIZE); // get channel inside band
+    // show frequence
+    widgets[WIDGET_SEEK_FREQUENCY].update(channelFrequency);
+
+    // show signal strength
+    widgets[WIDGET_SEEK_RSSI].update(map(rssi, 1, 100, 1, u8g.getWidth()-3));
+
+    uint8_t rssi_scaled=map(rssi, 1, 100, 1, 14);
+    if(channel != last_channel || rssi_scaled != last_rssi)
+    {
+        spectrum[channel] = rssi_scaled;
+        invalidateSpectrum(channel);
+    }
+
+    // handling for seek mode after screen and RSSI has been fully processed
+    if(state == STATE_SEEK) //
+    { // SEEK MODE
+        uint8_t threshold_scaled=map(rssi_seek_threshold, 1, 100, 1, 14);
+
+        widgets[WIDGET_SEEK_THRESHOLD_LEFT].update(14-threshold_scaled);
+        widgets[WIDGET_SEEK_THRESHOLD_RIGHT].update(14-threshold_scaled);
+
+        if(locked) // search if not found
+        {
+            widgets[WIDGET_SEEK_TITLE].update(PSTR("AUTO MODE LOCK"), WIDGET_INVERT);
+        }
+        else
+        {
+            widgets[WIDGET_SEEK_TITLE].update(PSTR("AUTO SEEK MODE"), WIDGET_INVERT);
+        }
+    }
+
+    last_channel = channel;
+    last_rssi = rssi_scaled;
+    render();
+}
+
+static void drawBandScanMode() {
+    if(shown_id == STATE_SCAN)
+    {
+        titleBox(PSTR("BAND SCANNER"));
+        drawTextP(5, 12, "BEST:");
+    }
+    else
+    {
+        titleBox(PSTR("RSSI SETUP"));
+        drawTextP(5, 12, "Min:     Max:");
+    }
+    u8g.drawHLine(0, 20, u8g.getWidth());
+    drawFrequencyScale();
+    drawSpectrum();
+}
+
+#ifdef USE_SCOUT
+template<> void u8gScreens::updateScout(uint8_t channel, uint8_t rssi) {
+    // drawn with the next updateSeekMode()
+    spectrum[channel] = map(rssi, 1, 100, 1, 14);
+    invalidateSpectrum(channel);
+}
+#endif
+
+template<> void u8gScreens::bandScanMode(uint8_t state) {
+    reset(); // start from fresh screen.
+    best_rssi = 0;
+    shown_id = state;
+    memset(spectrum, 0, sizeof(spectrum));
+    spectrum_height = 30;
+    scan_position = 0;
+
+    widgets[WIDGET_SCAN_NAME].number(36, 12, 2*6, 8, WIDGET_HEX);
+    widgets[WIDGET_SCAN_FREQUENCY].number(52, 12, 4*6, 8, 0);
+    widgets[WIDGET_SCAN_MIN].number(30, 12, 3*6, 8, 0);
+    widgets[WIDGET_SCAN_MAX].number(85, 12, 3*6, 8, 0);
+    show(drawBandScanMode);
+}
+
+template<> void u8gScreens::updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, uint8_t channelName, uint16_t channelFrequency, uint16_t rssi_setup_min_a, uint16_t rssi_setup_max_a) {
+    uint8_t rssi_scaled=map(rssi, 1, 100, 1, 30);
+    if(channel != last_channel) // only updated on changes
+    {
+        // whole pages are redrawn, this also covers the old cursor
+        spectrum[channel] = rssi_scaled;
+        invalidateSpectrum(channel);
+        scan_channel = channel;
+        scan_position = 3;
+    }
+    if(!in_setup) {
+        if (rssi > RSSI_SEEK_TRESHOLD) {
+            if(best_rssi < rssi) {
+                best_rssi = rssi;
+                widgets[WIDGET_SCAN_NAME].update(channelName);
+                widgets[WIDGET_SCAN_FREQUENCY].update(channelFrequency);
+            }
+        }
+    }
+    else {
+        widgets[WIDGET_SCAN_MIN].update(rssi_setup_min_a);
+        widgets[WIDGET_SCAN_MAX].update(rssi_setup_max_a);
+    }
+    render();
+    last_channel = channel;
+}
+
+// call sign is not terminated when all 10 letters are used
+static void printCallSign(uint8_t x, uint8_t y) {
+    u8g.setPrintPos(x, y);
+    for(uint8_t i=0; i<10 && shown_text[i]; i++) {
+        u8g.print(shown_text[i]);
+    }
+}
+
+// the layers are drawn for every page, Print would divide every digit.
+static void printNumber(uint16_t number, uint8_t style = 0) {
+    char text[NUM_SIZE];
+    numFormat(text, number, style);
+    u8g.print(text);
+}
+
+static void drawScreenSaver() {
+    u8g.setFont(u8g_font_fub30);
+    u8g.setPrintPos(0, 0);
+    printNumber(shown_channel, NUM_HEX);
+    u8g.setFont(u8g_font_6x10);
+    printCallSign(70, 0);
+    u8g.setFont(u8g_font_10x20);
+    u8g.setPrintPos(70, 26);
+    printNumber(shown_frequency);
+    u8g.setFont(u8g_font_6x10);
+#ifdef USE_VOLTAGE_MONITORING
+    if(shown_flag) {
+        u8g.setPrintPos(70, 9);
+        printNumber(shown_voltage, NUM_DECIMAL);
+        u8g.print('V');
+    }
+#endif
+#ifdef USE_DIVERSITY
+    if(shown_diversity) {
+        switch(shown_id) {
+            case useReceiverAuto:
+                drawTextP(70, 18, "AUTO");
+                break;
+            case useReceiverA:
+                drawTextP(70, 18, "ANTENNA A");
+                break;
+            case useReceiverB:
+                drawTextP(70, 18, "ANTENNA B");
+                break;
+        }
+        u8g.drawBox(0, u8g.getHeight()-19, 7, 9);
+        u8g.drawBox(0, u8g.getHeight()-9, 7, 9);
+        u8g.setColorIndex(BLACK);
+        drawTextP(1, u8g.getHeight()-18, "A");
+        drawTextP(1, u8g.getHeight()-8, "B");
+    }
+    else
+#endif
+    {
+        u8g.drawBox(0, u8g.getHeight()-19, 25, 19);
+        u8g.setColorIndex(BLACK);
+        drawTextP(1, u8g.getHeight()-13, "RSSI");
+    }
+}
+
+template<> void u8gScreens::screenSaver(uint8_t diversity_mode, uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
+    reset();
+    shown_id = diversity_mode;
+    shown_channel = channelName;
+    shown_frequency = channelFrequency;
+    shown_text = call_sign;
+    shown_flag = false;
+#ifdef USE_DIVERSITY
+    shown_diversity = isDiversity();
+    if(shown_diversity) {
+        widgets[WIDGET_RSSI_A].bar(7, u8g.getHeight()-19, 119, 9, 0);
+        widgets[WIDGET_RSSI_B].bar(7, u8g.getHeight()-9, 119, 9, 0);
+    }
+    else
+#endif
+    {
+        widgets[WIDGET_RSSI].bar(25, u8g.getHeight()-19, 101, 19, 0);
+    }
+    widgets[WIDGET_LOW_SIGNAL].label(50, u8g.getHeight()-13, 10*6, 8, 0);
+    show(drawScreenSaver);
+}
+
+template<> void u8gScreens::screenSaver(uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
+    screenSaver(-1, channelName, channelFrequency, call_sign);
+}
+
+template<> void u8gScreens::updateScreenSaver(char active_receiver, uint8_t rssi, uint8_t rssiA, uint8_t rssiB) {
+#ifdef USE_DIVERSITY
+    if(shown_diversity) {
+        #define RSSI_BAR_SIZE 119
+        widgets[WIDGET_RSSI_A].update(map(rssiA, 1, 100, 3, RSSI_BAR_SIZE), active_receiver == useReceiverA ? 0 : WIDGET_OUTLINE);
+        widgets[WIDGET_RSSI_B].update(map(rssiB, 1, 100, 3, RSSI_BAR_SIZE), active_receiver == useReceiverB ? 0 : WIDGET_OUTLINE);
+        #undef RSSI_BAR_SIZE
+    }
+    else
+#endif
+    {
+        #define RSSI_BAR_SIZE 101
+        widgets[WIDGET_RSSI].update(map(rssi, 1, 100, 1, RSSI_BAR_SIZE));
+        #undef RSSI_BAR_SIZE
+    }
+    // every page is redrawn from scratch, the warning leaves nothing behind.
+    widgets[WIDGET_LOW_SIGNAL].update((rssi < 20 && millis()%250 < 125) ? PSTR("LOW SIGNAL") : NULL);
+    render();
+}
+
+template<> void u8gScreens::updateScreenSaver(uint8_t rssi) {
+    updateScreenSaver(-1, rssi, -1, -1);
+}
+
+#ifdef USE_VOLTAGE_MONITORING
+template<> void u8gScreens::updateVoltageScreenSaver(int voltage, bool alarm){
+    bool visible = !alarm || millis()%250 < 125;
+    if(voltage != shown_voltage || visible != shown_flag) {
+        shown_voltage = voltage;
+        shown_flag = visible;
+        widgetInvalidate(70, 9, 6*6, 8);
+    }
+    render();
+}
+#endif
+
+#ifdef USE_DIVERSITY
+static void drawDiversity() {
+    uint8_t diversity_mode = shown_id;
+    titleBox(PSTR("DIVERSITY"));
+
+    //selected
+    u8g.drawBox(0, 10*diversity_mode+12, u8g.getWidth(), 10);
+
+    u8g.setColorIndex(diversity_mode == useReceiverAuto ? BLACK : WHITE);
+    drawTextP(5, 10*1+3, "AUTO");
+    u8g.setColorIndex(diversity_mode == useReceiverA ? BLACK : WHITE);
+    drawTextP(5, 10*2+3, "RECEIVER A");
+    u8g.setColorIndex(diversity_mode == useReceiverB ? BLACK : WHITE);
+    drawTextP(5, 10*3+3, "RECEIVER B");
+
+    // RSSI Strength
+    u8g.setColorIndex(WHITE);
+    u8g.drawFrame(0, u8g.getHeight()-21, u8g.getWidth(), 11);
+    drawTextP(5, u8g.getHeight()-19, "A:");
+    drawTextP(5, u8g.getHeight()-9, "B:");
+}
+
+template<> void u8gScreens::diversity(uint8_t diversity_mode) {
+    reset();
+    shown_id = diversity_mode;
+    widgets[WIDGET_RSSI_A].bar(18, u8g.getHeight()-19, 108, 7, 0);
+    widgets[WIDGET_RSSI_B].bar(18, u8g.getHeight()-9, 108, 7, 0);
+    show(drawDiversity);
+}
+
+template<> void u8gScreens::updateDiversity(char active_receiver, uint8_t rssiA, uint8_t rssiB){
+    #define RSSI_BAR_SIZE 108
+    widgets[WIDGET_RSSI_A].update(map(rssiA, 1, 100, 1, RSSI_BAR_SIZE), active_receiver == useReceiverA ? 0 : WIDGET_OUTLINE);
+    widgets[WIDGET_RSSI_B].update(map(rssiB, 1, 100, 1, RSSI_BAR_SIZE), active_receiver == useReceiverB ? 0 : WIDGET_OUTLINE);
+    #undef RSSI_BAR_SIZE
+    render();
+}
+#endif
+
+#ifdef USE_VOLTAGE_MONITORING
+static void drawVoltage() {
+    uint8_t menu_id = shown_id;
+    titleBox(PSTR("VOLTAGE ALARM"));
+
+    u8g.drawBox(0, 10*menu_id+12, u8g.getWidth(), 10);
+
+    u8g.setColorIndex(menu_id == 0 ? BLACK : WHITE);
+    drawTextP(5, 10*1+3, "Warning:");
+    u8g.setPrintPos(80, 10*1+3);
+    printNumber(shown_warning_voltage, NUM_DECIMAL);
+
+    u8g.setColorIndex(menu_id == 1 ? BLACK : WHITE);
+    drawTextP(5, 10*2+3, "Critical:");
+    u8g.setPrintPos(80, 10*2+3);
+    printNumber(shown_critical_voltage, NUM_DECIMAL);
+
+    u8g.setColorIndex(menu_id == 2 ? BLACK : WHITE);
+    drawTextP(5, 10*3+3, "Calibrate:");
+    u8g.setPrintPos(80, 10*3+3);
+    printNumber(shown_calibration);
+
+    u8g.setColorIndex(menu_id == 3 ? BLACK : WHITE);
+    drawTextP(5, 10*4+3, "Save");
+
+    u8g.setColorIndex(WHITE);
+    drawTextP(5, 10*5+3, "Measured:");
+    u8g.setPrintPos(80, 10*5+3);
+    printNumber(shown_voltage, NUM_DECIMAL);
+}
+
+template<> void u8gScreens::voltage(uint8_t menu_id, int voltage_calibration, uint8_t warning_voltage, uint8_t critical_voltage) {
+    reset();
+    shown_id = menu_id;
+    shown_calibration = voltage_calibration;
+    shown_warning_voltage = warning_voltage;
+    shown_critical_voltage = critical_voltage;
+    show(drawVoltage);
+}
+
+template<> void u8gScreens::updateVoltage(int voltage){
+    if(voltage != shown_voltage) {
+        shown_voltage = voltage;
+        widgetInvalidate(80, 53, 40, 10);
+    }
+    render();
+}
+#endif
+
+static void drawSetupMenu() {
+    uint8_t menu_id = shown_id;
+    titleBox(PSTR("SETUP MENU"));
+    //selected
+    uint8_t selected_position = menu_id % 5;
+    u8g.drawBox(0, 10*selected_position+12, u8g.getWidth(), 10);
+    if(menu_id < 5){
+        bottomTriangle(selected_position == 4 ? BLACK : WHITE);
+        u8g.setColorIndex(selected_position == 0 ? BLACK : WHITE);
+        drawTextP(5, 10*1+3, "ORDER: ");
+        if(shown_flag & 0x01) {
+            drawTextP(5+7*6, 10*1+3, "CHANNEL");
+        }
+        else {
+            drawTextP(5+7*6, 10*1+3, "FREQUENCY");
+        }
+
+        u8g.setColorIndex(selected_position == 1 ? BLACK : WHITE);
+        drawTextP(5, 10*2+3, "BEEPS: ");
+        if(shown_flag & 0x02) {
+            drawTextP(5+7*6, 10*2+3, "ON");
+        }
+        else {
+            drawTextP(5+7*6, 10*2+3, "OFF");
+        }
+
+        u8g.setColorIndex(selected_position == 2 ? BLACK : WHITE);
+        drawTextP(5, 10*3+3, "SIGN : ");
+        char editing = (char)shown_channel;
+        if(editing>=0) {
+            u8g.setColorIndex(BLACK);
+            u8g.drawBox(6*6+5, 10*2+13, u8g.getWidth()-(6*6+6), 8);
+            u8g.setColorIndex(WHITE);
+            u8g.drawBox(6*7+6*(editing)+4, 10*2+13, 7, 8); //set cursor
+        }
+        if(editing>=0) {
+            u8g.setPrintPos(5+7*6, 10*3+3);
+            for(uint8_t i=0; i<10; i++) {
+                u8g.setColorIndex(i == editing ? BLACK : WHITE);
+                u8g.print(shown_text[i]);
+            }
+        }
+        else {
+            printCallSign(5+7*6, 10*3+3);
+        }
+
+        u8g.setColorIndex(selected_position == 3 ? BLACK : WHITE);
+        drawTextP(5, 10*4+3, "CALIBRATE RSSI");
+
+#ifdef USE_VOLTAGE_MONITORING
+        u8g.setColorIndex(selected_position == 4 ? BLACK : WHITE);
+        drawTextP(5, 10*5+3, "VOLTAGE ALARM");
+    } else {
+        topTriangle(selected_position == 0 ? BLACK : WHITE);
+        u8g.setColorIndex(selected_position == 0 ? BLACK : WHITE);
+        drawTextP(5, 10*1+3, "SAVE & EXIT");
+    }
+#else
+        u8g.setColorIndex(selected_position == 4 ? BLACK : WHITE);
+        drawTextP(5, 10*5+3, "SAVE & EXIT");
+    }
+#endif
+}
+
+template<> void u8gScreens::setupMenu(){
+}
+template<> void u8gScreens::updateSetupMenu(uint8_t menu_id, bool settings_beeps, bool settings_orderby_channel, const char *call_sign, char editing){
+    reset();
+    shown_id = menu_id;
+    shown_flag = (settings_orderby_channel ? 0x01 : 0) | (settings_beeps ? 0x02 : 0);
+    shown_text = call_sign;
+    shown_channel = editing;
+    show(drawSetupMenu);
+}
+
+static void drawSave() {
+    titleBox(PSTR("SAVE SETTINGS"));
+
+    drawTextP(5, 8*1+4, "MODE:");
+    switch (shown_id)
+    {
+        case STATE_SCAN: // Band Scanner
+            drawTextP(38, 8*1+4, "BAND SCANNER");
+        break;
+        case STATE_MANUAL: // manual mode
+            drawTextP(38, 8*1+4, "MANUAL");
+        break;
+        case STATE_SEEK: // seek mode
+            drawTextP(38, 8*1+4, "AUTO SEEK");
+        break;
+    }
+
+    drawTextP(5, 8*2+4, "BAND:");
+    // print band
+    uint8_t channelIndex = shown_channel;
+#ifdef USE_LBAND
+    if(channelIndex > 39)
+    {
+        drawTextP(38, 8*2+4, "D/5.3");
+    }
+    else if(channelIndex > 31)
+#else
+    if(channelIndex > 31)
+#endif
+    {
+        drawTextP(38, 8*2+4, "C/Race");
+    }
+    else if(channelIndex > 23)
+    {
+        drawTextP(38, 8*2+4, "F/Airwave");
+    }
+    else if (channelIndex > 15)
+    {
+        drawTextP(38, 8*2+4, "E");
+    }
+    else if (channelIndex > 7)
+    {
+        drawTextP(38, 8*2+4, "B");
+    }
+    else
+    {
+        drawTextP(38, 8*2+4, "A");
+    }
+
+    drawTextP(5, 8*3+4, "CHAN:");
+    u8g.setPrintPos(38, 8*3+4);
+    printNumber(channelIndex%CHANNEL_BAND_SIZE+1); // get channel inside band
+    drawTextP(5, 8*4+4, "FREQ:     GHz");
+    u8g.setPrintPos(38, 8*4+4);
+    printNumber(shown_frequency);
+
+    drawTextP(5, 8*5+4, "SIGN:");
+    printCallSign(38, 8*5+4);
+
+    if(shown_message) {
+        u8g.drawStr(((u8g.getWidth()-strlen(shown_message)*6)/2), 8*6+4, shown_message);
+    }
+    else {
+        drawTextP(((u8g.getWidth()-11*6)/2), 8*6+4, "-- SAVED --");
+    }
+}
+
+template<> void u8gScreens::save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency, const char *call_sign) {
+    reset();
+    shown_id = mode;
+    shown_channel = channelIndex;
+    shown_frequency = channelFrequency;
+    shown_text = call_sign;
+    shown_message = NULL;
+    show(drawSave);
+}
+
+template<> void u8gScreens::updateSave(const char * msg) {
+    shown_message = msg;
+    widgetInvalidate(0, 8*6+4, u8g.getWidth(), 8);
+    render();
+}
+
+#ifdef USE_INSTRUMENTS
+// rates per second on the left, times in us on the right
+static void drawInstruments() {
+    titleBox(PSTR("INSTRUMENTS"));
+    drawTextP(2, 10*1+3, "LOOP");
+    drawTextP(2, 10*2+3, "ADC");
+    drawTextP(2, 10*3+3, "SW");
+    drawTextP(2, 10*4+3, "RAM");
+    drawTextP(66, 10*1+3, "RSSI");
+    drawTextP(66, 10*2+3, "TUNE");
+    drawTextP(66, 10*3+3, "DRAW");
+    drawTextP(66, 10*4+3, "EEPR");
+    drawTextP(2, 10*5+3, "PER SEC");
+    drawTextP(66, 10*5+3, "TIME US");
+    for(uint8_t i = 0; i < 8; i++) {
+        u8g.setPrintPos(i < 4 ? 32 : 96, 10*(i%4+1)+3);
+        printNumber(shown_instruments[i]);
+    }
+}
+
+template<> void u8gScreens::instruments() {
+    reset();
+    memset(shown_instruments, 0, sizeof(shown_instruments));
+    show(drawInstruments);
+}
+
+template<> void u8gScreens::updateInstruments(uint16_t loops, uint16_t adc_reads, uint16_t switches, uint16_t free_ram, uint16_t rssi_time, uint16_t tune_time, uint16_t draw_time, uint16_t eeprom_time) {
+    uint16_t values[] = { loops, adc_reads, switches, free_ram, rssi_time, tune_time, draw_time, eeprom_time };
+    for(uint8_t i = 0; i < 8; i++) {
+        if(values[i] != shown_instruments[i]) {
+            shown_instruments[i] = values[i];
+            widgetInvalidate(i < 4 ? 32 : 96, 10*(i%4+1)+3, 5*6, 8);
+        }
+    }
+    render();
+}
+#endif
+#endif
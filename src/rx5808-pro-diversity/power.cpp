@@ -0,0 +1,74 @@
+/*
+ * Power saving by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include "settings.h"
+
+#ifdef USE_SLEEP
+#include "power.h"
+
+#ifdef USE_SLEEP_STATS
+static unsigned long power_slept = 0; // us asleep since the last report
+static unsigned long power_report_time = 0;
+#endif
+
+void powerSleep() {
+#ifdef USE_SLEEP_STATS
+    unsigned long start = micros();
+#endif
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei(); // the instruction after sei runs before any interrupt
+    sleep_cpu();
+    sleep_disable();
+#ifdef USE_SLEEP_STATS
+    power_slept += micros() - start;
+#endif
+}
+
+void powerIdle(uint16_t ms) {
+    unsigned long start = millis();
+    while(millis() - start < ms) {
+        cli();
+        powerSleep(); // the millis timer wakes every 1ms
+    }
+}
+
+#ifdef USE_SLEEP_STATS
+void powerReport() {
+    unsigned long elapsed = millis() - power_report_time;
+    if(elapsed < 1000) {
+        return;
+    }
+    Serial.print("AWAKE ");
+    Serial.print(100 - power_slept / (elapsed * 10)); // percent
+    Serial.println('%');
+    power_slept = 0;
+    power_report_time += elapsed;
+}
+#endif
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Power saving by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef power_h
+#define power_h
+
+#include <stdint.h>
+
+// Power saving
+// The CPU sleeps in idle mode while the ADC converts and while the
+// receivers settle. Idle mode keeps the timers running, millis() and the
+// TVout sync do not notice, any interrupt wakes the CPU again.
+
+// sleeps until the next interrupt, call with interrupts disabled so the
+// wake up condition can be checked without a race. Interrupts are enabled
+// on return.
+void powerSleep();
+// like delay() but asleep between the timer ticks.
+void powerIdle(uint16_t ms);
+#ifdef USE_SLEEP_STATS
+// prints the awake time of the last second over serial, call it often.
+void powerReport();
+#endif
+
+#endif
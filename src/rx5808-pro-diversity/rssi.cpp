@@ -0,0 +1,217 @@
+/*
+ * Rssi math by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+#include "rssi.h"
+
+int rssiAverage(uint16_t sum, uint8_t values) {
+    return ((uint32_t)sum << RSSI_EXTRA_BITS) / values;
+}
+
+int rssiScale(int average, uint16_t min, uint16_t max) {
+    return map(average, min << RSSI_EXTRA_BITS, max << RSSI_EXTRA_BITS, RSSI_FINE, 100*RSSI_FINE);
+}
+
+#ifdef USE_DIVERSITY
+bool rssiCutover(int a, int b) {
+    return labs((long)a - b) * 100 >= (long)DIVERSITY_CUTOVER * abs(b);
+}
+#endif
+
+// in integers, 100 percent of best fits 32 bit.
+uint8_t seekThreshold(uint16_t best) {
+    return (uint32_t)best * RSSI_SEEK_TRESHOLD / 100;
+}
+
+uint8_t rssi_seek_threshold = RSSI_SEEK_TRESHOLD;
+uint16_t rssi_best = 0;
+uint8_t force_seek = 0;
+uint8_t seek_direction = 1;
+
+// the lock level follows the best rssi of the pass
+static void seekRaise() {
+    if(seekThreshold(rssi_best) > rssi_seek_threshold) {
+        rssi_seek_threshold = seekThreshold(rssi_best);
+    }
+}
+
+uint8_t seekLinear(uint8_t channel, uint8_t rssi) {
+    seekRaise();
+    if(!force_seek && rssi > rssi_seek_threshold) {
+        return SEEK_LOCK;
+    }
+    force_seek = 0;
+    int next = channel + (int8_t)seek_direction;
+    if(next > CHANNEL_MAX || next < CHANNEL_MIN) {
+        // calculate next pass new seek threshold
+        rssi_seek_threshold = seekThreshold(rssi_best);
+        next = next > CHANNEL_MAX ? CHANNEL_MIN : CHANNEL_MAX;
+        rssi_best = 0;
+    }
+    rssi_seek_threshold = rssi_seek_threshold < 5 ? 5 : rssi_seek_threshold; // make sure we are not stopping on everyting
+    return next;
+}
+
+#ifdef USE_GUIDED_SEEK
+uint8_t seek_candidates[SEEK_CANDIDATES];
+uint8_t seek_candidate_count = 0;
+uint8_t seek_candidate = 0;
+static uint8_t seek_confirm = 0;
+
+// moves the candidate left nearest to channel in seek_direction, around
+// the band, to the front of the ones left.
+static void seekToward(uint8_t channel) {
+    uint8_t nearest = seek_candidate;
+    uint8_t nearest_distance = 255;
+    for(uint8_t i = seek_candidate; i < seek_candidate_count; i++) {
+        int distance = ((int)seek_candidates[i] - channel) * (int8_t)seek_direction;
+        if(distance <= 0) {
+            distance += CHANNEL_MAX+1;
+        }
+        if(distance < nearest_distance) {
+            nearest_distance = distance;
+            nearest = i;
+        }
+    }
+    uint8_t position = seek_candidates[nearest];
+    seek_candidates[nearest] = seek_candidates[seek_candidate];
+    seek_candidates[seek_candidate] = position;
+}
+
+uint8_t seekGuided(uint8_t channel, uint8_t rssi) {
+    seekRaise();
+    if(!force_seek && rssi > rssi_seek_threshold) {
+        return ++seek_confirm >= SEEK_CONFIRM ? SEEK_LOCK : channel;
+    }
+    bool toward = force_seek;
+    force_seek = 0;
+    seek_confirm = 0;
+    if(seek_candidate >= seek_candidate_count) {
+        return SEEK_SWEEP;
+    }
+    if(toward) {
+        seekToward(channel);
+    }
+    return seek_candidates[seek_candidate++];
+}
+
+uint8_t seekSweep(uint8_t (*read)(uint8_t position)) {
+    uint8_t values[SEEK_CANDIDATES];
+    seek_candidate_count = 0;
+    for(uint8_t position = CHANNEL_MIN; position <= CHANNEL_MAX; position++) {
+        seek_candidate_count = seekRank(seek_candidates, values, seek_candidate_count, position, read(position));
+    }
+    // lock only on channels close to the strongest one
+    rssi_seek_threshold = seekThreshold(values[0]);
+    rssi_seek_threshold = rssi_seek_threshold < 5 ? 5 : rssi_seek_threshold;
+    rssi_best = 0;
+    seek_confirm = 0;
+    seek_candidate = 1;
+    return seek_candidates[0];
+}
+
+uint8_t seekRank(uint8_t *positions, uint8_t *values, uint8_t count, uint8_t position, uint8_t value) {
+    uint8_t i = count < SEEK_CANDIDATES ? count++ : SEEK_CANDIDATES;
+    for(; i > 0 && values[i-1] < value; i--) {
+        if(i < SEEK_CANDIDATES) {
+            values[i] = values[i-1];
+            positions[i] = positions[i-1];
+        }
+    }
+    if(i < SEEK_CANDIDATES) {
+        values[i] = value;
+        positions[i] = position;
+    }
+    return count;
+}
+#endif
+
+#ifdef USE_RSSI_FILTER
+#define SORT_PAIR(a, b) if(window[a] > window[b]) { uint16_t t = window[a]; window[a] = window[b]; window[b] = t; }
+// 9 compare sorting network of 5 reads.
+uint16_t rssiFilter(uint16_t *window, uint8_t filter) {
+    SORT_PAIR(0, 1); SORT_PAIR(3, 4); SORT_PAIR(2, 4);
+    SORT_PAIR(2, 3); SORT_PAIR(0, 3); SORT_PAIR(0, 2);
+    SORT_PAIR(1, 4); SORT_PAIR(1, 3); SORT_PAIR(1, 2);
+    if(filter == RSSI_FILTER_MEDIAN) {
+        return window[2];
+    }
+    return (window[1] + window[2] + window[3]) / 3;
+}
+
+uint8_t rssiFilterReads(uint8_t reads, uint8_t filter) {
+    if(filter == RSSI_FILTER_MEAN) {
+        return reads;
+    }
+    return (reads + RSSI_FILTER_WINDOW - 1) / RSSI_FILTER_WINDOW * RSSI_FILTER_WINDOW;
+}
+#endif
+
+#ifdef USE_ADAPTIVE_READS
+void rssiVariance(int16_t deviation, int16_t *sum, uint32_t *squares) {
+    // glitches are clipped, the sums stay within 32 bit for 64 reads
+    deviation = constrain(deviation, -255, 255);
+    *sum += deviation;
+    *squares += (int32_t)deviation*deviation;
+}
+
+// n^2*variance = n*squares - sum^2 has to be below target^2*n^3.
+bool rssiSettled(uint8_t n, int16_t sum, uint32_t squares) {
+    return (uint32_t)n*squares - (uint32_t)((int32_t)sum*sum) <= (uint32_t)RSSI_TARGET_ERROR*RSSI_TARGET_ERROR*n*n*n;
+}
+#endif
+
+#ifdef USE_TWO_PASS_SCAN
+uint8_t scan_coarse[CHANNEL_MAX+1];
+uint8_t scan_floor = 0;
+bool scan_fine = false;
+
+uint8_t scanNext(uint8_t channel, uint8_t rssi) {
+    uint8_t next = channel+1;
+    if(!scan_fine) {
+        scan_coarse[channel] = rssi;
+        if(next <= CHANNEL_MAX) {
+            return next;
+        }
+        // the quietest channel is the noise floor
+        scan_floor = 100;
+        for(uint8_t i=CHANNEL_MIN; i<=CHANNEL_MAX; i++) {
+            scan_floor = scan_coarse[i] < scan_floor ? scan_coarse[i] : scan_floor;
+        }
+        scan_floor += SCAN_NOISE_MARGIN;
+        scan_fine = true;
+        next = CHANNEL_MIN;
+    }
+    for(; next <= CHANNEL_MAX; next++) {
+        if(scan_coarse[next] > scan_floor) {
+            return next;
+        }
+    }
+    scan_fine = false;
+    return CHANNEL_MIN;
+}
+#endif
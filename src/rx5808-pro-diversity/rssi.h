@@ -0,0 +1,107 @@
+/*
+ * Rssi math by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef rssi_h
+#define rssi_h
+
+#include <stdint.h>
+#include "settings.h"
+
+// Rssi math
+// The arithmetic of readRSSI(), seek and the band scan without the
+// hardware, readings are 1..100 percent unless noted.
+
+// average of the reads with RSSI_EXTRA_BITS more bits, the read noise
+// dithers them.
+int rssiAverage(uint16_t sum, uint8_t values);
+// average to 1..100 percent in RSSI_FINE steps per percent, the
+// calibration is in adc steps. Not clipped.
+int rssiScale(int average, uint16_t min, uint16_t max);
+#ifdef USE_DIVERSITY
+// the receivers differ by DIVERSITY_CUTOVER percent of B or more
+bool rssiCutover(int a, int b);
+#endif
+
+// lock level of seek, RSSI_SEEK_TRESHOLD percent of the best rssi
+uint8_t seekThreshold(uint16_t best);
+
+// seek, the main loop reads the rssi of channel (a channelList position)
+// and takes the next step. Both strategies are here so they can be
+// compared, the main loop uses one of them.
+#define SEEK_LOCK 255  // locked on channel
+#define SEEK_SWEEP 254 // the candidates are used up, seekSweep() next
+extern uint8_t rssi_seek_threshold;
+extern uint16_t rssi_best; // of the seek pass or band scan
+extern uint8_t force_seek; // the next step moves on
+extern uint8_t seek_direction; // 1 up or -1 down the band
+// channel by channel in seek_direction, a pass over the band without a
+// lock lowers the lock level to the best of that pass.
+uint8_t seekLinear(uint8_t channel, uint8_t rssi);
+
+#ifdef USE_GUIDED_SEEK
+extern uint8_t seek_candidates[]; // channelList positions, strongest first
+extern uint8_t seek_candidate_count;
+extern uint8_t seek_candidate; // next candidate to check
+// the strongest candidates of the last sweep, locks after SEEK_CONFIRM
+// readings. A forced step goes to the nearest candidate left in
+// seek_direction.
+uint8_t seekGuided(uint8_t channel, uint8_t rssi);
+// reads every channelList position with read() and keeps the strongest as
+// candidates. Returns the first one to check.
+uint8_t seekSweep(uint8_t (*read)(uint8_t position));
+// sorted insert of a sweep reading into the candidates, strongest first,
+// the weakest drops out when all SEEK_CANDIDATES are taken. Returns the
+// new count.
+uint8_t seekRank(uint8_t *positions, uint8_t *values, uint8_t count, uint8_t position, uint8_t value);
+#endif
+
+#ifdef USE_RSSI_FILTER
+// RSSI_FILTER_MEDIAN or RSSI_FILTER_TRIMMED of a RSSI_FILTER_WINDOW read
+// window, the window is left sorted.
+uint16_t rssiFilter(uint16_t *window, uint8_t filter);
+// reads rounded up to full windows unless filter is RSSI_FILTER_MEAN, a
+// window that is not full gives no value.
+uint8_t rssiFilterReads(uint8_t reads, uint8_t filter);
+#endif
+
+#ifdef USE_ADAPTIVE_READS
+// adds a read to the sums of its distance to the first read
+void rssiVariance(int16_t deviation, int16_t *sum, uint32_t *squares);
+// true once the standard error of the average of n reads is below
+// RSSI_TARGET_ERROR adc steps.
+bool rssiSettled(uint8_t n, int16_t sum, uint32_t squares);
+#endif
+
+#ifdef USE_TWO_PASS_SCAN
+extern uint8_t scan_coarse[]; // rssi of the coarse pass per channelList position
+extern uint8_t scan_floor; // noise floor plus SCAN_NOISE_MARGIN
+extern bool scan_fine; // false restarts with the coarse pass
+// next channel of the band scan after the rssi of channel, the fine pass
+// skips the channels at the noise floor.
+uint8_t scanNext(uint8_t channel, uint8_t rssi);
+#endif
+
+#endif
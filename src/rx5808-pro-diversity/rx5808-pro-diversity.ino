@@ -55,64 +55,39 @@ SOFTWARE.
     #include <SPI.h>
 #endif
 #ifdef OLED_128x64_U8G_SCREENS
-//    #include <U8glib.h>
+    #include <U8glib.h>
+#endif
+#ifdef OLED_128x64_SSD1306_SCREENS
+    #include <Wire.h>
+    #include <fontALL.h>
 #endif
 
 #include "screens.h"
 screens drawScreen;
-
-// Channels to sent to the SPI registers
-const uint16_t channelTable[] PROGMEM = {
-  // Channel 1 - 8
-  0x2A05,    0x299B,    0x2991,    0x2987,    0x291D,    0x2913,    0x2909,    0x289F,    // Band A
-  0x2903,    0x290C,    0x2916,    0x291F,    0x2989,    0x2992,    0x299C,    0x2A05,    // Band B
-  0x2895,    0x288B,    0x2881,    0x2817,    0x2A0F,    0x2A19,    0x2A83,    0x2A8D,    // Band E
-  0x2906,    0x2910,    0x291A,    0x2984,    0x298E,    0x2998,    0x2A02,    0x2A0C,    // Band F / Airwave
-#ifdef USE_LBAND
-  0x281D,    0x288F,    0x2902,    0x2914,    0x2987,    0x2999,    0x2A0C,    0x2A1E,    // Band C / Immersion Raceband
-  0x2609,    0x261C,    0x268E,    0x2701,    0x2713,    0x2786,    0x2798,    0x280B     // Band D / 5.3
-#else
-  0x281D,    0x288F,    0x2902,    0x2914,    0x2987,    0x2999,    0x2A0C,    0x2A1E     // Band C / Immersion Raceband
-#endif
-};
-
-// Channels with their Mhz Values
-const uint16_t channelFreqTable[] PROGMEM = {
-  // Channel 1 - 8
-  5865, 5845, 5825, 5805, 5785, 5765, 5745, 5725, // Band A
-  5733, 5752, 5771, 5790, 5809, 5828, 5847, 5866, // Band B
-  5705, 5685, 5665, 5645, 5885, 5905, 5925, 5945, // Band E
-  5740, 5760, 5780, 5800, 5820, 5840, 5860, 5880, // Band F / Airwave
-#ifdef USE_LBAND
-  5658, 5695, 5732, 5769, 5806, 5843, 5880, 5917, // Band C / Immersion Raceband
-  5362, 5399, 5436, 5473, 5510, 5547, 5584, 5621  // Band D / 5.3
-#else
-  5658, 5695, 5732, 5769, 5806, 5843, 5880, 5917  // Band C / Immersion Raceband
-#endif
-};
-
-// do coding as simple hex value to save memory.
-const uint8_t channelNames[] PROGMEM = {
-  0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, // Band A
-  0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, // Band B
-  0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, // Band E
-  0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, // Band F / Airwave
-#ifdef USE_LBAND
-  0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, // Band C / Immersion Raceband
-  0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8  // BAND D / 5.3
-#else
-  0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8  // Band C / Immersion Raceband
+#include "adc.h"
+#include "buttons.h"
+#include "instruments.h"
+#include "trace.h"
+#include "boot.h"
+#include "hardware.h"
+#include "channels.h"
+#include "rssi.h"
+#ifdef USE_BENCHMARK
+#include "bench.h"
+#endif
+#ifdef USE_SIMBENCH
+#include "simbench.h"
+#endif
+#ifdef USE_SLEEP
+#include "power.h"
 #endif
-};
 
-// All Channels of the above List ordered by Mhz
-const uint8_t channelList[] PROGMEM = {
-#ifdef USE_LBAND
-  40, 41, 42, 43, 44, 45, 46, 47, 19, 18, 32, 17, 33, 16, 7, 34, 8, 24, 6, 9, 25, 5, 35, 10, 26, 4, 11, 27, 3, 36, 12, 28, 2, 13, 29, 37, 1, 14, 30, 0, 15, 31, 38, 20, 21, 39, 22, 23
-#else
-  19, 18, 32, 17, 33, 16, 7, 34, 8, 24, 6, 9, 25, 5, 35, 10, 26, 4, 11, 27, 3, 36, 12, 28, 2, 13, 29, 37, 1, 14, 30, 0, 15, 31, 38, 20, 21, 39, 22, 23
+#ifdef USE_SCOUT
+#include "scout.h"
+#endif
+#ifdef USE_LAP_TIMER
+#include "laptimer.h"
 #endif
-};
 
 char channel = 0;
 uint8_t channelIndex = 0;
@@ -123,7 +98,6 @@ uint8_t active_receiver = useReceiverA;
     uint8_t diversity_mode = useReceiverAuto;
     char diversity_check_count = 0; // used to decide when to change antennas.
 #endif
-uint8_t rssi_seek_threshold = RSSI_SEEK_TRESHOLD;
 uint8_t hight = 0;
 uint8_t state = START_STATE;
 uint8_t state_last_used=START_STATE;
@@ -132,19 +106,21 @@ uint8_t writePos = 0;
 uint8_t switch_count = 0;
 uint8_t man_channel = 0;
 uint8_t last_channel_index = 0;
-uint8_t force_seek=0;
-uint8_t seek_direction=1;
 unsigned long time_of_tune = 0;        // will store last time when tuner was changed
 unsigned long time_screen_saver = 0;
 unsigned long time_next_payload = 0;
 uint8_t last_active_channel=0;
 uint8_t seek_found=0;
+uint8_t rssi_reads=RSSI_READS; // reads per receiver in readRSSI()
+uint8_t rssi_reads_used=0; // reads the last readRSSI() took
+#ifdef USE_RSSI_FILTER
+uint8_t rssi_filter=RSSI_DIVERSITY_FILTER; // filter of readRSSI()
+#endif
 uint8_t last_dip_channel=255;
 uint8_t last_dip_band=255;
 uint8_t scan_start=0;
 uint8_t first_tune=1;
 boolean force_menu_redraw=0;
-uint16_t rssi_best=0; // used for band scaner
 uint16_t rssi_min_a=RSSI_MIN_VAL;
 uint16_t rssi_max_a=RSSI_MAX_VAL;
 uint16_t rssi_setup_min_a=RSSI_MIN_VAL;
@@ -210,6 +186,20 @@ void setup()
     pinMode (slaveSelectPin, OUTPUT);
     pinMode (spiDataPin, OUTPUT);
 	pinMode (spiClockPin, OUTPUT);
+#ifdef slaveSelectPinB
+    pinMode (slaveSelectPinB, OUTPUT);
+#endif
+#ifdef USE_FAST_BOOT
+    // video first, everything else can wait
+    channelIndex=EEPROM.read(EEPROM_ADR_TUNE);
+    if(channelIndex > CHANNEL_MAX_INDEX) { // unused eeprom
+        channelIndex=CHANNEL_MIN_INDEX;
+    }
+    setChannelModule(channelIndex);
+    time_of_tune=millis();
+    INSTR_BOOT(INSTR_BOOT_TUNED);
+#endif
+    hwProbe();
 
     // use values only of EEprom is not 255 = unsaved
     uint8_t eeprom_check = EEPROM.read(EEPROM_ADR_STATE);
@@ -257,9 +247,12 @@ void setup()
     // read last setting from eeprom
     state=EEPROM.read(EEPROM_ADR_STATE);
     channelIndex=EEPROM.read(EEPROM_ADR_TUNE);
+#ifndef USE_FAST_BOOT
     // set the channel as soon as we can
     // faster boot up times :)
     setChannelModule(channelIndex);
+    INSTR_BOOT(INSTR_BOOT_TUNED);
+#endif
     last_channel_index=channelIndex;
 
     settings_beeps=EEPROM.read(EEPROM_ADR_BEEP);
@@ -278,6 +271,26 @@ void setup()
     rssi_max_b=((EEPROM.read(EEPROM_ADR_RSSI_MAX_B_H)<<8) | (EEPROM.read(EEPROM_ADR_RSSI_MAX_B_L)));
 #endif
     force_menu_redraw=1;
+    INSTR_BOOT(INSTR_BOOT_SETTINGS);
+#ifdef USE_FAST_BOOT
+    adcBegin();
+#ifdef USE_DIVERSITY
+    if(!isDiversity()) {
+        diversity_mode = useReceiverAuto;
+    }
+    if(diversity_mode == useReceiverAuto) {
+        // the stronger receiver right away, the checks start from it
+        while(millis() - time_of_tune < MIN_TUNE_TIME);
+        bool useB = readRSSI(useReceiverB) > readRSSI(useReceiverA);
+        diversity_check_count = useB ? DIVERSITY_MAX_CHECKS : 0;
+        setReceiver(useB ? useReceiverB : useReceiverA);
+    }
+    else {
+        setReceiver(diversity_mode);
+    }
+#endif
+    INSTR_BOOT(INSTR_BOOT_RECEIVER);
+#endif
 
     // Init Display
     if (drawScreen.begin(call_sign) > 0) {
@@ -287,25 +300,54 @@ void setup()
             delay(100);
         }
     }
+    INSTR_BOOT(INSTR_BOOT_DISPLAY);
+#ifdef AUTO_SCREENS
+    hwProbe(); // the battery pin is known now
+#endif
 
-#ifdef USE_IR_EMITTER
-    // Used to Transmit IR Payloads
+#ifndef USE_FAST_BOOT
+    adcBegin();
+#endif
+    buttonsBegin();
+#ifdef USE_SERIAL
+    // Used to Transmit IR Payloads, lap times and reports
     Serial.begin(9600);
 #endif
+#ifdef USE_ADC_SELF_TEST
+    if(hwHas(HW_HELD_DOWN)) {
+        adcSelfTest();
+    }
+#endif
+#ifdef USE_INSTRUMENTS
+    if(hwHas(HW_HELD_UP)) {
+        state = STATE_INSTRUMENTS;
+    }
+#endif
+    TRACE(TRACE_BOOT, state, 0);
 
+#ifndef USE_FAST_BOOT
 #ifdef USE_DIVERSITY
     // make sure we use receiver Auto when diveristy is unplugged.
     if(!isDiversity()) {
         diversity_mode = useReceiverAuto;
     }
+#endif
+    INSTR_BOOT(INSTR_BOOT_RECEIVER);
 #endif
 #ifdef USE_VOLTAGE_MONITORING
         vbat_scale = EEPROM.read(EEPROM_ADR_VBAT_SCALE);
         warning_voltage = EEPROM.read(EEPROM_ADR_VBAT_WARNING);
         critical_voltage = EEPROM.read(EEPROM_ADR_VBAT_CRITICAL);
+#endif
+#ifdef USE_BENCHMARK
+    benchmarkRun();
+#endif
+#ifdef USE_SIMBENCH
+    simbenchRun(); // does not return
 #endif
     // Setup Done - Turn Status LED off.
     digitalWrite(led, LOW);
+    INSTR_BOOT(INSTR_BOOT_READY);
 
 }
 
@@ -313,30 +355,63 @@ void setup()
 // LOOP ----------------------------------------------------------------------------
 void loop()
 {
+#ifdef USE_INSTRUMENTS
+    bool instruments_ready = instrumentsLoop();
+#endif
+#ifdef USE_SLEEP_STATS
+    powerReport();
+#endif
+#ifdef USE_TRACE
+    traceLoop();
+#endif
+#ifdef USE_HW_REPROBE
+    if(hwLoop()) {
+#ifdef USE_DIVERSITY
+        if(!isDiversity()) {
+            diversity_mode = useReceiverAuto;
+        }
+#endif
+        force_menu_redraw=1;
+    }
+#endif
+#ifdef USE_FAST_BOOT
+    if(bootHolding()) {
+        readRSSI(); // the boot screen stays, the diversity works
+        return;
+    }
+#endif
     /*******************/
     /*   Mode Select   */
     /*******************/
     uint8_t in_menu;
-    uint8_t in_menu_time_out;
+    uint8_t key = buttonWait(0); // key of this round
+#ifdef USE_TRACE
+    // UP and DOWN together dump the trace, the second key is used up
+    if((key == (BUTTON_PRESS|BUTTON_UP) && buttonHeld(BUTTON_DOWN)) ||
+        (key == (BUTTON_PRESS|BUTTON_DOWN) && buttonHeld(BUTTON_UP)))
+    {
+        traceDump();
+        key = BUTTON_NONE;
+    }
+#endif
 
-    if (digitalRead(buttonMode) == LOW) // key pressed ?
+    if (key == (BUTTON_PRESS|BUTTON_MODE)) // key pressed ?
     {
 #ifdef USE_VOLTAGE_MONITORING
         clear_alarm();
 #endif
         time_screen_saver=0;
-        beep(50); // beep & debounce
-        delay(KEY_DEBOUNCE/2); // debounce
-        beep(50); // beep & debounce
-        delay(KEY_DEBOUNCE/2); // debounce
-
-        uint8_t press_time=0;
-        // on entry wait for release
-        while(digitalRead(buttonMode) == LOW && press_time < 10)
+        beep(50); // beep
+        delay(50);
+        beep(50); // beep
+
+        // on entry wait for release or the long press
+        uint8_t event;
+        do
         {
-            delay(100);
-            press_time++;
+            event = buttonEvent();
         }
+        while(event != (BUTTON_RELEASE|BUTTON_MODE) && event != (BUTTON_LONG|BUTTON_MODE));
         #define MAX_MENU 4
         #define MENU_Y_SIZE 15
 
@@ -347,7 +422,6 @@ void loop()
             state=STATE_SEEK;
         }
         in_menu=1;
-        in_menu_time_out=50; // 20x 100ms = 5 seconds
         /*
         Enter Mode menu
         Show current mode
@@ -357,7 +431,7 @@ void loop()
         */
         do
         {
-            if(press_time >= 10) // if menu held for 1 second invoke quick save.
+            if(event == (BUTTON_LONG|BUTTON_MODE)) // if menu held for 1 second invoke quick save.
             {
                 // user held the mode button and wants to quick save.
                 in_menu=0; // EXIT
@@ -400,32 +474,26 @@ void loop()
             // draw mode select screen
             drawScreen.mainMenu(menu_id);
 
-            while(digitalRead(buttonMode) == LOW || digitalRead(buttonUp) == LOW || digitalRead(buttonDown) == LOW)
-            {
-                // wait for MODE release
-                in_menu_time_out=50;
-            }
-            while(--in_menu_time_out && ((digitalRead(buttonMode) == HIGH) && (digitalRead(buttonUp) == HIGH) && (digitalRead(buttonDown) == HIGH))) // wait for next key press or time out
-            {
-                delay(100); // timeout delay
+            key = buttonWait(5000); // wait for next key press or time out
+            if(buttonType(key) == BUTTON_REPEAT) {
+                continue; // menu entries do not repeat
             }
-            if(in_menu_time_out==0 || digitalRead(buttonMode) == LOW)
+            if(key == BUTTON_NONE || key == (BUTTON_PRESS|BUTTON_MODE))
             {
-                if(digitalRead(buttonMode) != LOW) {
+                if(key == BUTTON_NONE) {
                     state=state_last_used; // exit to last state on timeout.
                 }
                 in_menu=0; // EXIT
-                beep(KEY_DEBOUNCE/2); // beep & debounce
-                delay(50); // debounce
-                beep(KEY_DEBOUNCE/2); // beep & debounce
-                delay(50); // debounce
+                beep(100); // beep
+                delay(50);
+                beep(100); // beep
             }
             else // no timeout, must be keypressed
             {
                 /*********************/
                 /*   Menu handler   */
                 /*********************/
-                if(digitalRead(buttonUp) == LOW) {
+                if(buttonId(key) == BUTTON_UP) {
                     menu_id--;
 #ifdef USE_DIVERSITY
                     if(!isDiversity() && menu_id == 3) { // make sure we back up two menu slots.
@@ -437,7 +505,7 @@ void loop()
                     }
 #endif
                 }
-                else if(digitalRead(buttonDown) == LOW) {
+                else if(buttonId(key) == BUTTON_DOWN) {
                     menu_id++;
                 }
 
@@ -449,9 +517,7 @@ void loop()
                 {
                     menu_id = MAX_MENU;
                 }
-                in_menu_time_out=50;
-                beep(50); // beep & debounce
-                delay(KEY_DEBOUNCE); // debounce
+                beep(50); // beep
             }
         } while(in_menu);
         last_state=255; // force redraw of current screen
@@ -465,7 +531,7 @@ void loop()
     /*     Save buttom     */
     /***********************/
     // hardware save buttom support (if no display is used)
-    if(digitalRead(buttonSave) == LOW)
+    if(key == (BUTTON_PRESS|BUTTON_SAVE))
     {
         state=STATE_SAVE;
     }
@@ -475,6 +541,31 @@ void loop()
     if(force_menu_redraw || state != last_state)
     {
         force_menu_redraw=0;
+        if(state != last_state)
+        {
+            TRACE(TRACE_STATE, state, last_state);
+        }
+#ifdef USE_SCOUT
+        // receiver B scouts in manual mode, it follows receiver A otherwise.
+        if(state == STATE_MANUAL && isDiversity()) {
+            scoutStart();
+        }
+        else if(scout_active) {
+            scoutStop();
+            setChannelModule(channelIndex);
+        }
+#endif
+#ifdef USE_LAP_TIMER
+        if(state == STATE_MANUAL) {
+            lapTimerStart();
+        }
+        else if(lap_active) {
+            lapTimerStop();
+#if LAP_PILOTS > 1
+            setChannelModule(channelIndex); // the receivers were time sliced
+#endif
+        }
+#endif
         /************************/
         /*   Main screen draw   */
         /************************/
@@ -515,6 +606,9 @@ void loop()
                 rssi_seek_threshold = RSSI_SEEK_TRESHOLD;
                 rssi_best=0;
                 force_seek=1;
+#ifdef USE_GUIDED_SEEK
+                seek_candidate_count=0; // sweep again
+#endif
             case STATE_MANUAL: // manual mode
                 if (state == STATE_MANUAL)
                 {
@@ -545,7 +639,13 @@ void loop()
             case STATE_SETUP_MENU:
 
             break;
+#ifdef USE_INSTRUMENTS
+            case STATE_INSTRUMENTS:
+                drawScreen.instruments();
+            break;
+#endif
             case STATE_SAVE:
+                INSTR_BEGIN(INSTR_EEPROM);
                 EEPROM.write(EEPROM_ADR_TUNE,channelIndex);
                 EEPROM.write(EEPROM_ADR_STATE,state_last_used);
                 EEPROM.write(EEPROM_ADR_BEEP,settings_beeps);
@@ -563,6 +663,7 @@ void loop()
                 EEPROM.write(EEPROM_ADR_VBAT_WARNING, warning_voltage);
                 EEPROM.write(EEPROM_ADR_VBAT_CRITICAL, critical_voltage);
 #endif
+                INSTR_END(INSTR_EEPROM);
                 drawScreen.save(state_last_used, channelIndex, pgm_read_word_near(channelFreqTable + channelIndex), call_sign);
                 for (uint8_t loop=0;loop<5;loop++)
                 {
@@ -578,12 +679,16 @@ void loop()
         } // end switch
 
         last_state=state;
+#ifdef USE_INSTRUMENTS
+        if(!instr_boot[INSTR_BOOT_MENU]) {
+            INSTR_BOOT(INSTR_BOOT_MENU);
+        }
+#endif
     }
     /*************************************/
     /*   Processing depending of state   */
     /*************************************/
-#ifndef TVOUT_SCREENS
-    if(state == STATE_SCREEN_SAVER) {
+    if(state == STATE_SCREEN_SAVER && !isTVOut()) {
 #ifdef USE_DIVERSITY
         drawScreen.screenSaver(diversity_mode, pgm_read_byte_near(channelNames + channelIndex), pgm_read_word_near(channelFreqTable + channelIndex), call_sign);
 #else
@@ -595,13 +700,21 @@ void loop()
             drawScreen.updateVoltageScreenSaver(voltage, warning_alarm || critical_alarm);
 #endif
         do{
+#ifdef USE_INSTRUMENTS
+            instrumentsLoop(); // the screen saver loops on its own
+#endif
             rssi = readRSSI();
 
 #ifdef USE_DIVERSITY
-            drawScreen.updateScreenSaver(active_receiver, rssi, readRSSI(useReceiverA), readRSSI(useReceiverB));
+            uint8_t rssiA = readRSSI(useReceiverA);
+            uint8_t rssiB = readRSSI(useReceiverB);
+            INSTR_BEGIN(INSTR_DRAW_SAVER);
+            drawScreen.updateScreenSaver(active_receiver, rssi, rssiA, rssiB);
 #else
+            INSTR_BEGIN(INSTR_DRAW_SAVER);
             drawScreen.updateScreenSaver(rssi);
 #endif
+            INSTR_END(INSTR_DRAW_SAVER);
 
 #ifdef USE_VOLTAGE_MONITORING
             read_voltage();
@@ -610,12 +723,11 @@ void loop()
             drawScreen.updateVoltageScreenSaver(voltage, warning_alarm || critical_alarm);
 #endif
         }
-        while((digitalRead(buttonMode) == HIGH) && (digitalRead(buttonUp) == HIGH) && (digitalRead(buttonDown) == HIGH)); // wait for next button press
+        while(buttonWait(0) == BUTTON_NONE); // wait for next button press
         state=state_last_used;
         time_screen_saver=0;
         return;
     }
-#endif
 #ifdef USE_VOLTAGE_MONITORING
     if(state == STATE_VOLTAGE) {
         // simple menu
@@ -630,9 +742,12 @@ void loop()
                 voltage_alarm();
                 //delay(100); // timeout delay
             }
-            while((digitalRead(buttonMode) == HIGH) && (digitalRead(buttonUp) == HIGH) && (digitalRead(buttonDown) == HIGH)); // wait for next key press
+            while((key = buttonWait(0)) == BUTTON_NONE); // wait for next key press
+            if(editing == -1 && buttonType(key) == BUTTON_REPEAT) {
+                continue; // only values repeat
+            }
 
-            if(digitalRead(buttonMode) == LOW){
+            if(key == (BUTTON_PRESS|BUTTON_MODE)){
                 if(editing > -1){
                     // user is done editing
                     editing = -1;
@@ -648,7 +763,7 @@ void loop()
                     state=STATE_SAVE;
                     editing = -1;
                 }
-            } else if(digitalRead(buttonDown) == LOW) {
+            } else if(buttonId(key) == BUTTON_DOWN) {
                 switch (editing) {
                     case 0:
                         warning_voltage--;
@@ -664,7 +779,7 @@ void loop()
                         break;
                 }
             }
-            else if(digitalRead(buttonUp) == LOW) {
+            else if(buttonId(key) == BUTTON_UP) {
                 switch (editing) {
                     case 0:
                         warning_voltage++;
@@ -687,12 +802,7 @@ void loop()
             if(menu_id < 0) {
                 menu_id = 3;
             }
-            beep(50); // beep & debounce
-            //delay(KEY_DEBOUNCE); // debounce
-            do{
-                delay(150);// wait for button release
-            }
-            while(editing==-1 && (digitalRead(buttonMode) == LOW || digitalRead(buttonUp) == LOW || digitalRead(buttonDown) == LOW));
+            beep(50); // beep
         }
         while(in_voltage_menu);
     }
@@ -710,18 +820,25 @@ void loop()
             {
                 //delay(10); // timeout delay
                 readRSSI();
-                drawScreen.updateDiversity(active_receiver, readRSSI(useReceiverA), readRSSI(useReceiverB));
+                uint8_t rssiA = readRSSI(useReceiverA);
+                uint8_t rssiB = readRSSI(useReceiverB);
+                INSTR_BEGIN(INSTR_DRAW_DIVERSITY);
+                drawScreen.updateDiversity(active_receiver, rssiA, rssiB);
+                INSTR_END(INSTR_DRAW_DIVERSITY);
+            }
+            while((key = buttonWait(0)) == BUTTON_NONE); // wait for next mode or time out
+            if(buttonType(key) == BUTTON_REPEAT) {
+                continue;
             }
-            while((digitalRead(buttonMode) == HIGH) && (digitalRead(buttonUp) == HIGH) && (digitalRead(buttonDown) == HIGH)); // wait for next mode or time out
 
-            if(digitalRead(buttonMode) == LOW)        // channel UP
+            if(key == (BUTTON_PRESS|BUTTON_MODE))        // channel UP
             {
                 in_menu = 0; // exit menu
             }
-            else if(digitalRead(buttonUp) == LOW) {
+            else if(buttonId(key) == BUTTON_UP) {
                 menu_id--;
             }
-            else if(digitalRead(buttonDown) == LOW) {
+            else if(buttonId(key) == BUTTON_DOWN) {
                 menu_id++;
             }
 
@@ -731,13 +848,31 @@ void loop()
             if(menu_id < 0) {
                 menu_id = useReceiverB;
             }
-            beep(50); // beep & debounce
-            delay(KEY_DEBOUNCE); // debounce
+            beep(50); // beep
         }
         while(in_menu);
 
         state=state_last_used;
     }
+#endif
+#ifdef USE_INSTRUMENTS
+    /*****************************/
+    /*   Processing INSTRUMENTS  */
+    /*****************************/
+    if(state == STATE_INSTRUMENTS)
+    {
+        // the receivers keep following the channel like in manual mode
+        wait_rssi_ready();
+        rssi = readRSSI();
+        if(instruments_ready)
+        {
+            INSTR_BEGIN(INSTR_DRAW_INSTRUMENTS);
+            // this screen is the only one drawn while it is shown
+            drawScreen.updateInstruments(instr_rate[INSTR_LOOPS], instr_rate[INSTR_ADC_READS], instr_rate[INSTR_SWITCHES], instr_free_ram,
+                instr_time[INSTR_RSSI], instr_time[INSTR_TUNE], instr_time[INSTR_DRAW_INSTRUMENTS], instr_time[INSTR_EEPROM]);
+            INSTR_END(INSTR_DRAW_INSTRUMENTS);
+        }
+    }
 #endif
     /*****************************************/
     /*   Processing MANUAL MODE / SEEK MODE  */
@@ -752,18 +887,19 @@ void loop()
         channel=channel_from_index(channelIndex); // get 0...48 index depending of current channel
         if(state == STATE_MANUAL) // MANUAL MODE
         {
-#ifdef USE_IR_EMITTER
+#if defined(USE_IR_EMITTER) && !defined(USE_LAP_TIMER)
             if(time_next_payload+1000 < millis() && rssi <= 50) { // send channel info every second until rssi is locked.
                 sendIRPayload();
                 time_next_payload = millis();
             }
 #endif
             // handling of keys
-            if( digitalRead(buttonUp) == LOW)        // channel UP
+            if(buttonId(key) == BUTTON_UP)        // channel UP
             {
                 time_screen_saver=millis();
-                beep(50); // beep & debounce
-                delay(KEY_DEBOUNCE); // debounce
+                if(buttonType(key) == BUTTON_PRESS) {
+                    beep(50); // beep, the repeats are too fast
+                }
                 channelIndex++;
                 channel++;
                 channel > CHANNEL_MAX ? channel = CHANNEL_MIN : false;
@@ -772,11 +908,12 @@ void loop()
                     channelIndex = CHANNEL_MIN_INDEX;
                 }
             }
-            if( digitalRead(buttonDown) == LOW) // channel DOWN
+            if(buttonId(key) == BUTTON_DOWN) // channel DOWN
             {
                 time_screen_saver=millis();
-                beep(50); // beep & debounce
-                delay(KEY_DEBOUNCE); // debounce
+                if(buttonType(key) == BUTTON_PRESS) {
+                    beep(50); // beep, the repeats are too fast
+                }
                 channelIndex--;
                 channel--;
                 channel < CHANNEL_MIN ? channel = CHANNEL_MAX : false;
@@ -789,6 +926,32 @@ void loop()
             if(!settings_orderby_channel) { // order by frequency
                 channelIndex = pgm_read_byte_near(channelList + channel);
             }
+#ifdef USE_LAP_TIMER
+            if(channelIndex != last_channel_index) { // new channel, new race
+                lapTimerStop();
+                lapTimerStart();
+            }
+            else if(lapTimerRun(LAP_SAMPLE_TIME)) {
+                beep(50);
+            }
+#endif
+#ifdef USE_SCOUT
+            if(scoutUpdate(channelIndex)) {
+                if(scout_event == SCOUT_INTERFERENCE) {
+                    beep(100);
+                    delay(100);
+                    beep(100);
+                    delay(100);
+                    beep(100);
+                }
+                else if(scout_event == SCOUT_NEW) {
+                    beep(100);
+                }
+                if(scout_position != channel) { // receiver A draws its own channel
+                    drawScreen.updateScout(scout_position, scout_rssi[scout_position]);
+                }
+            }
+#endif
 
         }
 
@@ -796,14 +959,24 @@ void loop()
         if(state == STATE_SEEK) //
         { // SEEK MODE
 
-            // recalculate rssi_seek_threshold
-            ((int)((float)rssi_best * (float)(RSSI_SEEK_TRESHOLD/100.0)) > rssi_seek_threshold) ? (rssi_seek_threshold = (int)((float)rssi_best * (float)(RSSI_SEEK_TRESHOLD/100.0))) : false;
-
             if(!seek_found) // search if not found
             {
-                if ((!force_seek) && (rssi > rssi_seek_threshold)) // check for found channel
+#ifdef USE_GUIDED_SEEK
+                uint8_t next = seekGuided(channel, rssi);
+                if(next == SEEK_SWEEP) // the candidates are used up
+                {
+                    next = seekSweep(seekSweepRead);
+                    // back to the channel the main loop has tuned
+                    setChannelModule(last_channel_index);
+                    time_of_tune=millis();
+                }
+#else
+                uint8_t next = seekLinear(channel, rssi);
+#endif
+                if (next == SEEK_LOCK) // check for found channel
                 {
                     seek_found=1;
+                    TRACE(TRACE_LOCK, pgm_read_byte_near(channelNames + channelIndex), rssi);
                     time_screen_saver=millis();
                     // beep twice as notice of lock
                     beep(100);
@@ -812,24 +985,7 @@ void loop()
                 }
                 else
                 { // seeking itself
-                    force_seek=0;
-                    // next channel
-                    channel+=seek_direction;
-                    if (channel > CHANNEL_MAX)
-                    {
-                        // calculate next pass new seek threshold
-                        rssi_seek_threshold = (int)((float)rssi_best * (float)(RSSI_SEEK_TRESHOLD/100.0));
-                        channel=CHANNEL_MIN;
-                        rssi_best = 0;
-                    }
-                    else if(channel < CHANNEL_MIN)
-                    {
-                        // calculate next pass new seek threshold
-                        rssi_seek_threshold = (int)((float)rssi_best * (float)(RSSI_SEEK_TRESHOLD/100.0));
-                        channel=CHANNEL_MAX;
-                        rssi_best = 0;
-                    }
-                    rssi_seek_threshold = rssi_seek_threshold < 5 ? 5 : rssi_seek_threshold; // make sure we are not stopping on everyting
+                    channel = next;
                     channelIndex = pgm_read_byte_near(channelList + channel);
                 }
             }
@@ -837,29 +993,28 @@ void loop()
             { // seek was successful
 
             }
-            if (digitalRead(buttonUp) == LOW || digitalRead(buttonDown) == LOW) // restart seek if key pressed
+            if (key == (BUTTON_PRESS|BUTTON_UP) || key == (BUTTON_PRESS|BUTTON_DOWN)) // restart seek if key pressed
             {
-                if(digitalRead(buttonUp) == LOW) {
+                if(buttonId(key) == BUTTON_UP) {
                     seek_direction = 1;
                 }
                 else {
                     seek_direction = -1;
                 }
-                beep(50); // beep & debounce
-                delay(KEY_DEBOUNCE); // debounce
+                beep(50); // beep
                 force_seek=1;
                 seek_found=0;
                 time_screen_saver=0;
             }
         }
-#ifndef TVOUT_SCREENS
         // change to screensaver after lock and 5 seconds has passed.
-        if(time_screen_saver+5000 < millis() && time_screen_saver != 0 && rssi > 50 ||
-            (time_screen_saver != 0 && time_screen_saver + (SCREENSAVER_TIMEOUT*1000) < millis())) {
+        if(!isTVOut() && (time_screen_saver+5000 < millis() && time_screen_saver != 0 && rssi > 50 ||
+            (time_screen_saver != 0 && time_screen_saver + (SCREENSAVER_TIMEOUT*1000) < millis()))) {
             state = STATE_SCREEN_SAVER;
         }
-#endif
+        INSTR_BEGIN(INSTR_DRAW_SEEK);
         drawScreen.updateSeekMode(state, channelIndex, channel, rssi, pgm_read_word_near(channelFreqTable + channelIndex), rssi_seek_threshold, seek_found);
+        INSTR_END(INSTR_DRAW_SEEK);
     }
     /****************************/
     /*   Processing SCAN MODE   */
@@ -872,12 +1027,30 @@ void loop()
             scan_start=0;
             setChannelModule(channelIndex);
             last_channel_index=channelIndex;
+#ifdef USE_TWO_PASS_SCAN
+            scan_fine=false;
+#endif
         }
 
         // print bar for spectrum
         wait_rssi_ready();
         // value must be ready
+#ifdef USE_RSSI_FILTER
+        rssi_filter = RSSI_SCAN_FILTER;
+#endif
+#ifdef USE_TWO_PASS_SCAN
+        if(state == STATE_SCAN)
+        {
+            rssi_reads = scan_fine ? SCAN_FINE_READS : SCAN_COARSE_READS;
+        }
+        rssi = readRSSI();
+        rssi_reads = RSSI_READS;
+#else
         rssi = readRSSI();
+#endif
+#ifdef USE_RSSI_FILTER
+        rssi_filter = RSSI_DIVERSITY_FILTER;
+#endif
 
         if(state == STATE_SCAN)
         {
@@ -892,9 +1065,18 @@ void loop()
         uint8_t bestChannelName = pgm_read_byte_near(channelNames + channelIndex);
         uint16_t bestChannelFrequency = pgm_read_word_near(channelFreqTable + channelIndex);
 
+        INSTR_BEGIN(INSTR_DRAW_SCAN);
         drawScreen.updateBandScanMode((state == STATE_RSSI_SETUP), channel, rssi, bestChannelName, bestChannelFrequency, rssi_setup_min_a, rssi_setup_max_a);
+        INSTR_END(INSTR_DRAW_SCAN);
 
         // next channel
+#ifdef USE_TWO_PASS_SCAN
+        if (state == STATE_SCAN)
+        {
+            channel = scanNext(channel, rssi);
+        }
+        else
+#endif
         if (channel < CHANNEL_MAX)
         {
             channel++;
@@ -912,6 +1094,7 @@ void loop()
                     if(rssi_max_a < 125) { // user probably did not turn on the VTX during calibration
                         rssi_max_a = RSSI_MAX_VAL;
                     }
+                    INSTR_BEGIN(INSTR_EEPROM);
                     // save 16 bit
                     EEPROM.write(EEPROM_ADR_RSSI_MIN_A_L,(rssi_min_a & 0xff));
                     EEPROM.write(EEPROM_ADR_RSSI_MIN_A_H,(rssi_min_a >> 8));
@@ -935,16 +1118,16 @@ void loop()
                         EEPROM.write(EEPROM_ADR_RSSI_MAX_B_H,(rssi_max_b >> 8));
                     }
 #endif
+                    INSTR_END(INSTR_EEPROM);
                     state=EEPROM.read(EEPROM_ADR_STATE);
                     beep(1000);
                 }
             }
         }
         // new scan possible by press scan
-        if (digitalRead(buttonUp) == LOW) // force new full new scan
+        if (key == (BUTTON_PRESS|BUTTON_UP)) // force new full new scan
         {
-            beep(50); // beep & debounce
-            delay(KEY_DEBOUNCE); // debounce
+            beep(50); // beep
             last_state=255; // force redraw by fake state change ;-)
             channel=CHANNEL_MIN;
             scan_start=1;
@@ -963,19 +1146,18 @@ void loop()
         drawScreen.setupMenu();
         int editing = -1;
         do{
-            in_menu_time_out=80;
             drawScreen.updateSetupMenu(menu_id, settings_beeps, settings_orderby_channel, call_sign, editing);
-            while(--in_menu_time_out && ((digitalRead(buttonMode) == HIGH) && (digitalRead(buttonUp) == HIGH) && (digitalRead(buttonDown) == HIGH))) // wait for next key press or time out
-            {
-                delay(100); // timeout delay
-            }
+            key = buttonWait(8000); // wait for next key press or time out
 
-            if(in_menu_time_out <= 0 ) {
+            if(key == BUTTON_NONE) {
                 state = state_last_used;
                 break; // Timed out, Don't save...
             }
+            if(editing == -1 && buttonType(key) == BUTTON_REPEAT) {
+                continue; // only letters repeat
+            }
 
-            if(digitalRead(buttonMode) == LOW)        // modeButton
+            if(key == (BUTTON_PRESS|BUTTON_MODE))        // modeButton
             {
                 // do something about the users selection
                 switch(menu_id) {
@@ -1017,14 +1199,12 @@ void loop()
 
                 }
             }
-            else if(digitalRead(buttonUp) == LOW) {
+            else if(buttonId(key) == BUTTON_UP) {
                 if(editing == -1) {
                     menu_id--;
-#ifdef TVOUT_SCREENS
-                    if(menu_id == 2) {
+                    if(isTVOut() && menu_id == 2) {
                         menu_id--;
                     }
-#endif
                 }
                 else { // change current letter in place
                     call_sign[editing]++;
@@ -1032,15 +1212,13 @@ void loop()
                 }
 
             }
-            else if(digitalRead(buttonDown) == LOW) {
+            else if(buttonId(key) == BUTTON_DOWN) {
                 if(editing == -1) {
                     menu_id++;
 
-#ifdef TVOUT_SCREENS
-                    if(menu_id == 2) {
+                    if(isTVOut() && menu_id == 2) {
                         menu_id++;
                     }
-#endif
                 }
                 else { // change current letter in place
                     call_sign[editing]--;
@@ -1055,11 +1233,7 @@ void loop()
                 menu_id = SETUP_MENU_MAX_ITEMS;
             }
 
-            beep(50); // beep & debounce
-            do{
-                delay(150);// wait for button release
-            }
-            while(editing==-1 && (digitalRead(buttonMode) == LOW || digitalRead(buttonUp) == LOW || digitalRead(buttonDown) == LOW));
+            beep(50); // beep
         }
         while(in_menu);
     }
@@ -1067,7 +1241,10 @@ void loop()
     /*****************************/
     /*   General house keeping   */
     /*****************************/
-    if(last_channel_index != channelIndex)         // tune channel on demand
+    // manual mode tunes once the channel key is released, only the
+    // shown channel moves while it repeats.
+    if(last_channel_index != channelIndex &&         // tune channel on demand
+        !(state == STATE_MANUAL && (buttonHeld(BUTTON_UP) || buttonHeld(BUTTON_DOWN))))
     {
         setChannelModule(channelIndex);
         last_channel_index=channelIndex;
@@ -1130,10 +1307,29 @@ void wait_rssi_ready()
     if(tune_time < MIN_TUNE_TIME)
     {
         // wait until tune time is full filled
+#ifdef USE_SLEEP
+        powerIdle(MIN_TUNE_TIME-tune_time);
+#else
         delay(MIN_TUNE_TIME-tune_time);
+#endif
     }
 }
 
+#ifdef USE_GUIDED_SEEK
+// reading of a channelList position for the seek sweep, it only has to
+// be good enough to rank the channels.
+uint8_t seekSweepRead(uint8_t position)
+{
+    setChannelModule(pgm_read_byte_near(channelList + position));
+    delay(SEEK_SWEEP_TUNE_TIME);
+#ifdef USE_DIVERSITY
+    return readRSSI(useReceiverA); // no receiver switching while sweeping
+#else
+    return readRSSI();
+#endif
+}
+#endif
+
 uint16_t readRSSI()
 {
 #ifdef USE_DIVERSITY
@@ -1142,59 +1338,137 @@ uint16_t readRSSI()
 uint16_t readRSSI(char receiver)
 {
 #endif
+    INSTR_BEGIN(INSTR_RSSI);
     int rssi = 0;
     int rssiA = 0;
+    uint16_t sumA = 0; // up to 64 reads of 10 bit
 
 #ifdef USE_DIVERSITY
     int rssiB = 0;
+    uint16_t sumB = 0;
+#endif
+#ifdef USE_ADAPTIVE_READS
+    // sums of the distance to the first read for the variance
+    int16_t firstA = 0, devA = 0;
+    uint32_t sqA = 0;
+#ifdef USE_DIVERSITY
+    int16_t firstB = 0, devB = 0;
+    uint32_t sqB = 0;
+#endif
 #endif
-    for (uint8_t i = 0; i < RSSI_READS; i++)
+#ifdef USE_RSSI_FILTER
+    uint16_t windowA[RSSI_FILTER_WINDOW];
+#ifdef USE_DIVERSITY
+    uint16_t windowB[RSSI_FILTER_WINDOW];
+#endif
+#endif
+    uint8_t reads = 0;
+    uint8_t values = 0; // reads or filtered windows in the sums
+#ifdef USE_RSSI_FILTER
+    uint8_t wanted = rssiFilterReads(rssi_reads, rssi_filter);
+#else
+    uint8_t wanted = rssi_reads;
+#endif
+    while (reads < wanted || !values)
     {
-        rssiA += analogRead(rssiPinA);//random(RSSI_MAX_VAL-200, RSSI_MAX_VAL);//
+        uint16_t readA = adcRead(rssiPinA);//random(RSSI_MAX_VAL-200, RSSI_MAX_VAL);//
 
 #ifdef USE_DIVERSITY
-        rssiB += analogRead(rssiPinB);//random(RSSI_MAX_VAL-200, RSSI_MAX_VAL);//
+        uint16_t readB = adcRead(rssiPinB);//random(RSSI_MAX_VAL-200, RSSI_MAX_VAL);//
+#endif
+        reads++;
+#ifdef USE_RSSI_FILTER
+        if(rssi_filter != RSSI_FILTER_MEAN)
+        { // every full window gives one value
+            windowA[(reads-1) % RSSI_FILTER_WINDOW] = readA;
+#ifdef USE_DIVERSITY
+            windowB[(reads-1) % RSSI_FILTER_WINDOW] = readB;
+#endif
+            if(reads % RSSI_FILTER_WINDOW)
+            {
+                continue;
+            }
+            readA = rssiFilter(windowA, rssi_filter);
+#ifdef USE_DIVERSITY
+            readB = rssiFilter(windowB, rssi_filter);
+#endif
+        }
+#endif
+        sumA += readA;
+#ifdef USE_DIVERSITY
+        sumB += readB;
+#endif
+        values++;
+#ifdef USE_ADAPTIVE_READS
+        if(values == 1)
+        {
+            firstA = readA;
+#ifdef USE_DIVERSITY
+            firstB = readB;
+#endif
+        }
+        rssiVariance(readA - firstA, &devA, &sqA);
+#ifdef USE_DIVERSITY
+        rssiVariance(readB - firstB, &devB, &sqB);
+#endif
+        if(reads >= RSSI_MIN_READS && values >= 2 && rssiSettled(values, devA, sqA)
+#ifdef USE_DIVERSITY
+            && rssiSettled(values, devB, sqB)
+#endif
+        )
+        {
+            break;
+        }
 #endif
     }
-    rssiA = rssiA/RSSI_READS; // average of RSSI_READS readings
-
+    rssi_reads_used = reads;
+    rssiA = rssiAverage(sumA, values);
 #ifdef USE_DIVERSITY
-    rssiB = rssiB/RSSI_READS; // average of RSSI_READS readings
+    rssiB = rssiAverage(sumB, values);
 #endif
     // special case for RSSI setup
     if(state==STATE_RSSI_SETUP)
     { // RSSI setup
-        if(rssiA < rssi_setup_min_a)
+        // calibration is kept in adc steps
+        if(rssiA >> RSSI_EXTRA_BITS < rssi_setup_min_a)
         {
-            rssi_setup_min_a=rssiA;
+            rssi_setup_min_a=rssiA >> RSSI_EXTRA_BITS;
         }
-        if(rssiA > rssi_setup_max_a)
+        if(rssiA >> RSSI_EXTRA_BITS > rssi_setup_max_a)
         {
-            rssi_setup_max_a=rssiA;
+            rssi_setup_max_a=rssiA >> RSSI_EXTRA_BITS;
         }
 
 #ifdef USE_DIVERSITY
-        if(rssiB < rssi_setup_min_b)
+        if(rssiB >> RSSI_EXTRA_BITS < rssi_setup_min_b)
         {
-            rssi_setup_min_b=rssiB;
+            rssi_setup_min_b=rssiB >> RSSI_EXTRA_BITS;
         }
-        if(rssiB > rssi_setup_max_b)
+        if(rssiB >> RSSI_EXTRA_BITS > rssi_setup_max_b)
         {
-            rssi_setup_max_b=rssiB;
+            rssi_setup_max_b=rssiB >> RSSI_EXTRA_BITS;
         }
 #endif
     }
 
-    rssiA = map(rssiA, rssi_min_a, rssi_max_a , 1, 100);   // scale from 1..100%
+    rssiA = rssiScale(rssiA, rssi_min_a, rssi_max_a);
 #ifdef USE_DIVERSITY
-    rssiB = map(rssiB, rssi_min_b, rssi_max_b , 1, 100);   // scale from 1..100%
+    rssiB = rssiScale(rssiB, rssi_min_b, rssi_max_b);
     if(receiver == -1) // no receiver was chosen using diversity
     {
+#ifdef USE_SCOUT
+        // receiver B is somewhere else while scouting.
+        switch(scout_active ? useReceiverA : diversity_mode)
+#elif defined(LAP_SPLIT_RECEIVERS) && LAP_PILOTS > 1
+        // receiver B times the other pilots while the lap timer runs.
+        switch(lap_active ? useReceiverA : diversity_mode)
+#else
         switch(diversity_mode)
+#endif
         {
             case useReceiverAuto:
                 // select receiver
-                if((int)abs((float)(((float)rssiA - (float)rssiB) / (float)rssiB) * 100.0) >= DIVERSITY_CUTOVER)
+                if(rssiCutover(rssiA, rssiB))
                 {
                     if(rssiA > rssiB && diversity_check_count > 0)
                     {
@@ -1223,6 +1497,10 @@ uint16_t readRSSI(char receiver)
             default:
                 receiver=useReceiverA;
         }
+        if(receiver != active_receiver)
+        {
+            TRACE(receiver == useReceiverA ? TRACE_SWITCH_A : TRACE_SWITCH_B, constrain(rssiA / RSSI_FINE, 0, 255), constrain(rssiB / RSSI_FINE, 0, 255));
+        }
         // set the antenna LED and switch the video
         setReceiver(receiver);
     }
@@ -1239,10 +1517,17 @@ uint16_t readRSSI(char receiver)
         rssi = rssiB;
     }
 #endif
+#ifdef USE_RSSI_12BIT
+    rssi = (rssi + RSSI_FINE/2) / RSSI_FINE; // percent only for the callers
+#endif
+    INSTR_END(INSTR_RSSI);
     return constrain(rssi,1,100); // clip values to only be within this range.
 }
 
 void setReceiver(uint8_t receiver) {
+    if(receiver != active_receiver) {
+        INSTR_COUNT(INSTR_SWITCHES);
+    }
 #ifdef USE_DIVERSITY
     if(receiver == useReceiverA)
     {
@@ -1286,6 +1571,35 @@ void sendIRPayload() {
 
 void setChannelModule(uint8_t channel)
 {
+  uint8_t receivers = 1; // trace mask, 1 A, 2 B
+#ifdef slaveSelectPinB
+#ifdef USE_SCOUT
+  // receiver B only follows while it is not scouting.
+  if(!scout_active)
+#endif
+  {
+    writeChannelModule(channel, slaveSelectPinB);
+    receivers |= 2;
+  }
+#endif
+  writeChannelModule(channel, slaveSelectPin);
+  TRACE(TRACE_TUNE, pgm_read_byte_near(channelNames + channel), receivers);
+}
+
+// one receiver, the scout and the lap timer tune them apart.
+void setChannelModule(uint8_t channel, uint8_t select_pin)
+{
+  writeChannelModule(channel, select_pin);
+#ifdef slaveSelectPinB
+  TRACE(TRACE_TUNE, pgm_read_byte_near(channelNames + channel), select_pin == slaveSelectPinB ? 2 : 1);
+#else
+  TRACE(TRACE_TUNE, pgm_read_byte_near(channelNames + channel), 1);
+#endif
+}
+
+void writeChannelModule(uint8_t channel, uint8_t select_pin)
+{
+  INSTR_BEGIN(INSTR_TUNE);
   uint8_t i;
   uint16_t channelData;
 
@@ -1294,10 +1608,10 @@ void setChannelModule(uint8_t channel)
   // bit bash out 25 bits of data
   // Order: A0-3, !R/W, D0-D19
   // A0=0, A1=0, A2=0, A3=1, RW=0, D0-19=0
-  SERIAL_ENABLE_HIGH();
+  SERIAL_ENABLE_HIGH(select_pin);
   delayMicroseconds(1);
   //delay(2);
-  SERIAL_ENABLE_LOW();
+  SERIAL_ENABLE_LOW(select_pin);
 
   SERIAL_SENDBIT0();
   SERIAL_SENDBIT0();
@@ -1311,16 +1625,16 @@ void setChannelModule(uint8_t channel)
     SERIAL_SENDBIT0();
 
   // Clock the data in
-  SERIAL_ENABLE_HIGH();
+  SERIAL_ENABLE_HIGH(select_pin);
   //delay(2);
   delayMicroseconds(1);
-  SERIAL_ENABLE_LOW();
+  SERIAL_ENABLE_LOW(select_pin);
 
   // Second is the channel data from the lookup table
   // 20 bytes of register data are sent, but the MSB 4 bits are zeros
   // register address = 0x1, write, data0-15=channelData data15-19=0x0
-  SERIAL_ENABLE_HIGH();
-  SERIAL_ENABLE_LOW();
+  SERIAL_ENABLE_HIGH(select_pin);
+  SERIAL_ENABLE_LOW(select_pin);
 
   // Register 0x1
   SERIAL_SENDBIT1();
@@ -1354,13 +1668,14 @@ void setChannelModule(uint8_t channel)
     SERIAL_SENDBIT0();
 
   // Finished clocking data in
-  SERIAL_ENABLE_HIGH();
+  SERIAL_ENABLE_HIGH(select_pin);
   delayMicroseconds(1);
   //delay(2);
 
-  digitalWrite(slaveSelectPin, LOW);
+  digitalWrite(select_pin, LOW);
   digitalWrite(spiClockPin, LOW);
   digitalWrite(spiDataPin, LOW);
+  INSTR_END(INSTR_TUNE);
 }
 
 
@@ -1392,17 +1707,17 @@ void SERIAL_SENDBIT0()
   delayMicroseconds(1);
 }
 
-void SERIAL_ENABLE_LOW()
+void SERIAL_ENABLE_LOW(uint8_t select_pin)
 {
   delayMicroseconds(1);
-  digitalWrite(slaveSelectPin, LOW);
+  digitalWrite(select_pin, LOW);
   delayMicroseconds(1);
 }
 
-void SERIAL_ENABLE_HIGH()
+void SERIAL_ENABLE_HIGH(uint8_t select_pin)
 {
   delayMicroseconds(1);
-  digitalWrite(slaveSelectPin, HIGH);
+  digitalWrite(select_pin, HIGH);
   delayMicroseconds(1);
 }
 
@@ -1410,7 +1725,7 @@ void SERIAL_ENABLE_HIGH()
 #ifdef USE_VOLTAGE_MONITORING
 void read_voltage()
 {
-    uint16_t v = analogRead(VBAT_PIN);
+    uint16_t v = adcRead(VBAT_PIN); // shared with the lap timer tick
     voltages_sum += v;
     voltages_sum -= voltages[voltage_reading_index];
     voltages[voltage_reading_index++] = v;
@@ -1422,7 +1737,11 @@ void read_voltage()
 #else
     voltage = ((voltages_sum /VBAT_SMOOTH) * VBAT_PRESCALER) / vbat_scale + VBAT_OFFSET; // result is Vbatt in 0.1V steps
 #endif
-    if(voltage <= critical_voltage) {
+    if(!hwHas(HW_VBAT)) {
+        // no battery on the divider, no alarms
+        critical_alarm = false;
+        warning_alarm = false;
+    } else if(voltage <= critical_voltage) {
         critical_alarm = true;
         warning_alarm = false;
     } else if(voltage <= warning_voltage) {
@@ -0,0 +1,99 @@
+/*
+ * Scout receiver by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+#include "adc.h"
+
+#ifdef USE_SCOUT
+#include "scout.h"
+
+// main project
+extern uint16_t rssi_min_b;
+extern uint16_t rssi_max_b;
+void setChannelModule(uint8_t channel, uint8_t select_pin);
+
+bool scout_active = false;
+uint8_t scout_position = 0;
+uint8_t scout_event = SCOUT_NONE;
+uint8_t scout_rssi[CHANNEL_MAX+1];
+
+static uint8_t scout_tuned = 0; // position receiver B is tuned to
+static unsigned long scout_time_of_tune = 0;
+static bool scout_first_sweep = true; // no alarms until every channel was seen once
+
+void scoutStart() {
+    if(scout_active) {
+        return;
+    }
+    scout_active = true;
+    scout_first_sweep = true;
+    scout_tuned = CHANNEL_MIN;
+    memset(scout_rssi, 0, sizeof(scout_rssi));
+    setChannelModule(pgm_read_byte_near(channelList + scout_tuned), slaveSelectPinB);
+    scout_time_of_tune = millis();
+}
+
+void scoutStop() {
+    scout_active = false;
+}
+
+bool scoutUpdate(uint8_t watched_index) {
+    if(!scout_active || millis() - scout_time_of_tune < MIN_TUNE_TIME) {
+        return false;
+    }
+    uint16_t sum = 0;
+    for(uint8_t i=0; i<RSSI_READS; i++) {
+        sum += adcRead(rssiPinB);
+    }
+    int rssi = map(sum/RSSI_READS, rssi_min_b, rssi_max_b, 1, 100);
+    rssi = constrain(rssi, 1, 100);
+
+    scout_position = scout_tuned;
+    uint8_t index = pgm_read_byte_near(channelList + scout_position);
+    uint8_t last_rssi = scout_rssi[scout_position];
+    scout_rssi[scout_position] = rssi;
+    scout_event = SCOUT_NONE;
+    if(!scout_first_sweep && rssi >= RSSI_SEEK_FOUND && last_rssi < RSSI_SEEK_FOUND) {
+        // by frequency, the bands share channels and the watched transmitter
+        // also shows up a few MHz off its own channel.
+        int spacing = pgm_read_word_near(channelFreqTable + index) - pgm_read_word_near(channelFreqTable + watched_index);
+        spacing = abs(spacing);
+        if(spacing >= SCOUT_SELF_MHZ) {
+            scout_event = spacing < SCOUT_GUARD_MHZ ? SCOUT_INTERFERENCE : SCOUT_NEW;
+        }
+    }
+
+    // tune B to the next channel, it settles while A is in use.
+    if(++scout_tuned > CHANNEL_MAX) {
+        scout_tuned = CHANNEL_MIN;
+        scout_first_sweep = false;
+    }
+    setChannelModule(pgm_read_byte_near(channelList + scout_tuned), slaveSelectPinB);
+    scout_time_of_tune = millis();
+    return true;
+}
+#endif
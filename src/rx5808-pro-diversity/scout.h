@@ -0,0 +1,53 @@
+/*
+ * Scout receiver by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef scout_h
+#define scout_h
+
+#include <avr/pgmspace.h>
+#include "channels.h"
+
+// Scout receiver
+// Receiver A stays on the channel that is watched while receiver B sweeps
+// channelList in the background. Receiver B needs its own select line on
+// slaveSelectPinB, the modules can not be tuned apart otherwise.
+// scoutUpdate() never waits, it takes a reading once B has settled.
+
+#define SCOUT_NONE 0
+#define SCOUT_NEW 1          // a transmitter showed up on a quiet channel
+#define SCOUT_INTERFERENCE 2 // a transmitter showed up next to the watched channel
+
+extern bool scout_active;
+extern uint8_t scout_position; // position in channelList of the last reading
+extern uint8_t scout_event; // SCOUT_ event of the last reading
+extern uint8_t scout_rssi[]; // last reading per channelList position, 1..100
+
+void scoutStart();
+void scoutStop(); // receiver B has to be tuned to the watched channel again
+// returns true if a new reading was taken.
+bool scoutUpdate(uint8_t watched_index);
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ * Screens Class by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "settings.h"
+
+#ifdef AUTO_SCREENS
+#include "screens.h"
+#include <Arduino.h>
+#include <Wire.h>
+
+#define OLED_ADDRESS 0x3C
+#define SCREENS_CALL(call) (screens_display == DISPLAY_TVOUT ? tv.call : oled.call)
+
+uint8_t screens_display = DISPLAY_TVOUT;
+
+// an OLED on the I2C bus is used if it answers, TV out otherwise.
+static bool probeOLED() {
+    // without a display there are no pull ups and the bus would hang,
+    // on TV out receivers A4 is the battery voltage input.
+    if(digitalRead(SDA) == LOW || digitalRead(SCL) == LOW) {
+        return false;
+    }
+    Wire.begin();
+    Wire.beginTransmission(OLED_ADDRESS);
+    if(Wire.endTransmission() == 0) {
+        return true;
+    }
+    // give the pins back, the internal pull ups would pull up VBAT.
+    TWCR = 0;
+    digitalWrite(SDA, LOW);
+    digitalWrite(SCL, LOW);
+    return false;
+}
+
+char screens::begin(const char *call_sign) {
+    screens_display = probeOLED() ? DISPLAY_OLED_SSD1306 : DISPLAY_TVOUT;
+    return SCREENS_CALL(begin(call_sign));
+}
+
+void screens::flip() {
+    SCREENS_CALL(flip());
+}
+
+void screens::mainMenu(uint8_t menu_id) {
+    SCREENS_CALL(mainMenu(menu_id));
+}
+
+void screens::seekMode(uint8_t state) {
+    SCREENS_CALL(seekMode(state));
+}
+
+void screens::updateSeekMode(uint8_t state, uint8_t channelIndex, uint8_t channel, uint8_t rssi, uint16_t channelFrequency, uint8_t rssi_seek_threshold, bool locked) {
+    SCREENS_CALL(updateSeekMode(state, channelIndex, channel, rssi, channelFrequency, rssi_seek_threshold, locked));
+}
+
+#ifdef USE_SCOUT
+void screens::updateScout(uint8_t channel, uint8_t rssi) {
+    SCREENS_CALL(updateScout(channel, rssi));
+}
+#endif
+
+void screens::bandScanMode(uint8_t state) {
+    SCREENS_CALL(bandScanMode(state));
+}
+
+void screens::updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, uint8_t channelName, uint16_t channelFrequency, uint16_t rssi_setup_min_a, uint16_t rssi_setup_max_a) {
+    SCREENS_CALL(updateBandScanMode(in_setup, channel, rssi, channelName, channelFrequency, rssi_setup_min_a, rssi_setup_max_a));
+}
+
+void screens::screenSaver(uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
+    SCREENS_CALL(screenSaver(channelName, channelFrequency, call_sign));
+}
+
+void screens::screenSaver(uint8_t diversity_mode, uint8_t channelName, uint16_t channelFrequency, const char *call_sign) {
+    SCREENS_CALL(screenSaver(diversity_mode, channelName, channelFrequency, call_sign));
+}
+
+void screens::updateScreenSaver(uint8_t rssi) {
+    SCREENS_CALL(updateScreenSaver(rssi));
+}
+
+void screens::updateScreenSaver(char active_receiver, uint8_t rssi, uint8_t rssiA, uint8_t rssiB) {
+    SCREENS_CALL(updateScreenSaver(active_receiver, rssi, rssiA, rssiB));
+}
+
+#ifdef USE_VOLTAGE_MONITORING
+void screens::updateVoltageScreenSaver(int voltage, bool alarm) {
+    SCREENS_CALL(updateVoltageScreenSaver(voltage, alarm));
+}
+#endif
+
+#ifdef USE_DIVERSITY
+void screens::diversity(uint8_t diversity_mode) {
+    SCREENS_CALL(diversity(diversity_mode));
+}
+
+void screens::updateDiversity(char active_receiver, uint8_t rssiA, uint8_t rssiB) {
+    SCREENS_CALL(updateDiversity(active_receiver, rssiA, rssiB));
+}
+#endif
+
+#ifdef USE_VOLTAGE_MONITORING
+void screens::voltage(uint8_t menu_id, int voltage_calibration, uint8_t warning_voltage, uint8_t critical_voltage) {
+    SCREENS_CALL(voltage(menu_id, voltage_calibration, warning_voltage, critical_voltage));
+}
+
+void screens::updateVoltage(int voltage) {
+    SCREENS_CALL(updateVoltage(voltage));
+}
+#endif
+
+void screens::setupMenu() {
+    SCREENS_CALL(setupMenu());
+}
+
+void screens::updateSetupMenu(uint8_t menu_id,bool settings_beeps,bool settings_orderby_channel, const char *call_sign, char editing) {
+    SCREENS_CALL(updateSetupMenu(menu_id, settings_beeps, settings_orderby_channel, call_sign, editing));
+}
+
+void screens::save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency, const char *call_sign) {
+    SCREENS_CALL(save(mode, channelIndex, channelFrequency, call_sign));
+}
+
+void screens::updateSave(const char *msg) {
+    SCREENS_CALL(updateSave(msg));
+}
+
+#ifdef USE_INSTRUMENTS
+void screens::instruments() {
+    SCREENS_CALL(instruments());
+}
+
+void screens::updateInstruments(uint16_t loops, uint16_t adc_reads, uint16_t switches, uint16_t free_ram, uint16_t rssi_time, uint16_t tune_time, uint16_t draw_time, uint16_t eeprom_time) {
+    SCREENS_CALL(updateInstruments(loops, adc_reads, switches, free_ram, rssi_time, tune_time, draw_time, eeprom_time));
+}
+#endif
+
+#endif
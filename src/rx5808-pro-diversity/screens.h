@@ -29,6 +29,29 @@ SOFTWARE.
 
 
 #include <avr/pgmspace.h>
+#include "settings.h"
+
+// Displays, every screens backend implements screens_t for one of them.
+#define DISPLAY_TVOUT 0
+#define DISPLAY_OLED_ADAFRUIT 1
+#define DISPLAY_OLED_U8G 2
+#define DISPLAY_OLED_SSD1306 3
+
+#if defined(AUTO_SCREENS)
+    // TV out and the SSD1306 are both built in, begin() picks one.
+    extern uint8_t screens_display;
+    #define SCREENS_DISPLAY screens_display
+#elif defined(TVOUT_SCREENS)
+    #define SCREENS_DISPLAY DISPLAY_TVOUT
+#elif defined(OLED_128x64_ADAFRUIT_SCREENS)
+    #define SCREENS_DISPLAY DISPLAY_OLED_ADAFRUIT
+#elif defined(OLED_128x64_U8G_SCREENS)
+    #define SCREENS_DISPLAY DISPLAY_OLED_U8G
+#elif defined(OLED_128x64_SSD1306_SCREENS)
+    #define SCREENS_DISPLAY DISPLAY_OLED_SSD1306
+#endif
+
+#define isTVOut() (SCREENS_DISPLAY == DISPLAY_TVOUT)
 
 //Each screen has the following
 // public entry method
@@ -36,7 +59,9 @@ SOFTWARE.
 // public update method
 // private update draw method
 
-class screens
+// The methods are specialized by the backends, there are no virtual
+// functions so nothing ends up in RAM and calls are resolved at compile time.
+template<uint8_t display> class screens_t
 {
     private: // helper functions for screens.
         uint8_t last_rssi;
@@ -48,7 +73,7 @@ class screens
         void drawBottomTriangle(bool color);
 
     public:
-        screens();
+        screens_t();
         char begin(const char *call_sign);
         void flip();
 
@@ -58,6 +83,9 @@ class screens
         // SEEK & MANUAL MODE
         void seekMode(uint8_t state); // seek and manual mode
         void updateSeekMode(uint8_t state, uint8_t channelIndex, uint8_t channel, uint8_t rssi, uint16_t channelFrequency, uint8_t rssi_seek_threshold, bool locked); // seek and manual mode
+#ifdef USE_SCOUT
+        void updateScout(uint8_t channel, uint8_t rssi); // spectrum bar from receiver B in manual mode
+#endif
 
         // BAND SCAN
         void bandScanMode(uint8_t state);
@@ -89,5 +117,66 @@ class screens
         // SAVE
         void save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency, const char *call_sign);
         void updateSave(const char *msg);
+
+        // INSTRUMENTS
+#ifdef USE_INSTRUMENTS
+        void instruments();
+        void updateInstruments(uint16_t loops, uint16_t adc_reads, uint16_t switches, uint16_t free_ram, uint16_t rssi_time, uint16_t tune_time, uint16_t draw_time, uint16_t eeprom_time); // rates per second, times in us
+#endif
+};
+
+#ifdef AUTO_SCREENS
+// forwards to the display found at boot, see screens.cpp
+class screens
+{
+    private:
+        screens_t<DISPLAY_TVOUT> tv;
+        screens_t<DISPLAY_OLED_SSD1306> oled;
+
+    public:
+        char begin(const char *call_sign);
+        void flip();
+
+        void mainMenu(uint8_t menu_id);
+
+        void seekMode(uint8_t state);
+        void updateSeekMode(uint8_t state, uint8_t channelIndex, uint8_t channel, uint8_t rssi, uint16_t channelFrequency, uint8_t rssi_seek_threshold, bool locked);
+#ifdef USE_SCOUT
+        void updateScout(uint8_t channel, uint8_t rssi);
+#endif
+
+        void bandScanMode(uint8_t state);
+        void updateBandScanMode(bool in_setup, uint8_t channel, uint8_t rssi, uint8_t channelName, uint16_t channelFrequency, uint16_t rssi_setup_min_a, uint16_t rssi_setup_max_a);
+
+        void screenSaver(uint8_t channelName, uint16_t channelFrequency, const char *call_sign);
+        void screenSaver(uint8_t diversity_mode, uint8_t channelName, uint16_t channelFrequency, const char *call_sign);
+        void updateScreenSaver(uint8_t rssi);
+        void updateScreenSaver(char active_receiver, uint8_t rssi, uint8_t rssiA, uint8_t rssiB);
+#ifdef USE_VOLTAGE_MONITORING
+        void updateVoltageScreenSaver(int voltage, bool alarm);
+#endif
+
+        void diversity(uint8_t diversity_mode);
+        void updateDiversity(char active_receiver, uint8_t rssiA, uint8_t rssiB);
+
+#ifdef USE_VOLTAGE_MONITORING
+        void voltage(uint8_t menu_id, int voltage_calibration, uint8_t warning_voltage, uint8_t critical_voltage);
+        void updateVoltage(int voltage);
+#endif
+
+        void setupMenu();
+        void updateSetupMenu(uint8_t menu_id,bool settings_beeps,bool settings_orderby_channel, const char *call_sign, char editing);
+
+        void save(uint8_t mode, uint8_t channelIndex, uint16_t channelFrequency, const char *call_sign);
+        void updateSave(const char *msg);
+
+#ifdef USE_INSTRUMENTS
+        void instruments();
+        void updateInstruments(uint16_t loops, uint16_t adc_reads, uint16_t switches, uint16_t free_ram, uint16_t rssi_time, uint16_t tune_time, uint16_t draw_time, uint16_t eeprom_time);
+#endif
 };
+#else
+typedef screens_t<SCREENS_DISPLAY> screens;
+#endif
+
 #endif
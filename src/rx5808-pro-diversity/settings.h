@@ -32,12 +32,30 @@ SOFTWARE.
 //#define TVOUT_SCREENS
 #define OLED_128x64_ADAFRUIT_SCREENS
 
-// use the library from https://github.com/badzz/Adafruit_SH1106 before enabling
+// SH1106 controller instead of the SSD1306, OLED_128x64_SSD1306_SCREENS
+// drive it directly, the Adafruit screens need the library from
+// https://github.com/badzz/Adafruit_SH1106 before enabling
 //#define SH1106
 
-// u8glib has performance issues.
+// u8glib runs in page mode, it needs 1KB less RAM than the Adafruit library.
 //#define OLED_128x64_U8G_SCREENS
 
+// SSD1306 without a frame buffer, screens are sent a page at a time
+// from a display list. Needs the TVoutfonts library.
+//#define OLED_128x64_SSD1306_SCREENS
+
+// TV out and the SSD1306 screens in one build, the display is picked at boot.
+// An OLED answering on I2C is used, TV out otherwise.
+// The TVout and SSD1306 includes in the main project are both needed.
+//#define AUTO_SCREENS
+#ifdef AUTO_SCREENS
+    #if defined(OLED_128x64_ADAFRUIT_SCREENS) || defined(OLED_128x64_U8G_SCREENS)
+        #error "AUTO_SCREENS only supports TV out and OLED_128x64_SSD1306_SCREENS"
+    #endif
+    #define TVOUT_SCREENS
+    #define OLED_128x64_SSD1306_SCREENS
+#endif
+
 // this will be displayed on the screensaver.
 // Up to 10 letters
 #define CALL_SIGN "CALL SIGN"
@@ -49,6 +67,60 @@ SOFTWARE.
 #define USE_BOOT_LOGO
 // You can use any of the arduino analog pins to measure the voltage of the battery
 //#define USE_VOLTAGE_MONITORING
+// Receiver B sweeps the band in manual mode while A stays on the video,
+// needs diversity and the select line of receiver B on slaveSelectPinB.
+//#define USE_SCOUT
+// Time laps on the manual mode channel, lap times are sent over serial
+// at 9600 baud instead of the IR payload.
+//#define USE_LAP_TIMER
+// Receiver B times every other pilot when more than one pilot is timed,
+// needs diversity and the select line of receiver B on slaveSelectPinB.
+// The video stays on receiver A while the lap timer runs.
+//#define LAP_SPLIT_RECEIVERS
+// Seek sweeps the whole band quickly first and then only checks the
+// strongest channels, strongest first. UP and DOWN go to the nearest of
+// them above or below.
+//#define USE_GUIDED_SEEK
+// The band scan takes a quick look at every channel and measures only
+// the channels above the noise floor again with more samples.
+//#define USE_TWO_PASS_SCAN
+// readRSSI() stops reading once the average is precise enough, stable
+// signals need a few reads only.
+//#define USE_ADAPTIVE_READS
+// readRSSI() takes the median or a trimmed mean of every 5 reads, single
+// multipath spikes do not move the average or switch the receiver then.
+//#define USE_RSSI_FILTER
+// readRSSI() keeps two more bits of the averaged reads, the diversity
+// compares the receivers in tenths of a percent then.
+//#define USE_RSSI_12BIT
+// Hold DOWN while powering up to print the time and noise of the rssi
+// reads for every ADC prescaler over serial.
+//#define USE_ADC_SELF_TEST
+// Sleep while the ADC converts and while the receivers settle, saves
+// power and the rssi reads are quieter.
+//#define USE_SLEEP
+// prints the percentage of every second spent awake over serial.
+//#define USE_SLEEP_STATS
+// Measures the loop rate, the time spent reading rssi, tuning, drawing
+// and writing the EEPROM and the free ram. Reported every second over
+// serial, hold UP while powering up for the debug screen.
+//#define USE_INSTRUMENTS
+// Keeps the last tunes, receiver switches, seek locks, state changes,
+// display flushes and loop stalls in ram. Send 'T' over serial or press
+// UP and DOWN together to dump them, tools/trace_decode.py reads the dump.
+//#define USE_TRACE
+// Runs the hot paths at boot and sends their cost in cycles over serial,
+// tools/bench_compare.py compares two reports.
+//#define USE_BENCHMARK
+// Runs scripted scenarios for the simulator benchmarks after setup, set
+// by tools/simbench/simbench.py. Not for use on a receiver.
+//#define USE_SIMBENCH
+// Tunes the saved channel and picks the receiver before the display is
+// set up, the boot screen stays up while the diversity already works.
+//#define USE_FAST_BOOT
+// Probes receiver B and the battery divider again every few seconds, they
+// can be plugged in while running then.
+//#define USE_HW_REPROBE
 // Choose if you wish to use 8 additional Channels
 // 5362 MHz 5399 MHz 5436 MHz 5473 MHz 5510 MHz 5547 MHz 5584 MHz 5621 MHz
 // Local laws may prohibit the use of these frequencies use at your own risk!
@@ -63,6 +135,10 @@ SOFTWARE.
 #define spiDataPin 10
 #define slaveSelectPin 11
 #define spiClockPin 12
+#if defined(USE_SCOUT) || defined(LAP_SPLIT_RECEIVERS)
+    // select line of receiver B, cut from slaveSelectPin.
+    #define slaveSelectPinB 8
+#endif
 
 // Receiver PINS
 #define receiverA_led A0
@@ -85,6 +161,48 @@ SOFTWARE.
     #define DIVERSITY_MAX_CHECKS 5
 #endif
 
+#ifdef USE_SCOUT
+    #ifndef USE_DIVERSITY
+        #error "USE_SCOUT needs USE_DIVERSITY"
+    #endif
+    // a transmitter showing up closer than this to the watched channel is interference.
+    #define SCOUT_GUARD_MHZ 30
+    // closer than this it is the watched transmitter itself, on a channel of
+    // another band with the same frequency or one next to it.
+    #define SCOUT_SELF_MHZ 10
+#endif
+
+#ifdef USE_LAP_TIMER
+    // a pass starts above the enter and ends below the exit threshold,
+    // in percent of the calibrated rssi range of receiver A.
+    #define LAP_ENTER_THRESHOLD 80
+    #define LAP_EXIT_THRESHOLD 60
+    // passes closer than this are the same pass (ms)
+    #define LAP_MIN_TIME 3000
+    // ms between samples of the timer tick with one pilot, the ADC
+    // converts between the last two ticks
+    #define LAP_SAMPLE_TICKS 2
+    // ms sliced between screen updates with more than one pilot
+    #define LAP_SAMPLE_TIME 40
+    // running average over 2^LAP_FILTER_SHIFT samples
+    #define LAP_FILTER_SHIFT 3
+    // pilots timed at once, more than one pilot time slices the receivers
+    // over LAP_PILOT_CHANNELS (channelTable index, 32 is R1) and the manual
+    // mode video follows the slices.
+    #define LAP_PILOTS 1
+    #define LAP_PILOT_CHANNELS 32, 34, 37, 39 // R1 R3 R6 R8
+    // rssi reads per pilot and slice
+    #define LAP_SLICE_READS 16
+    #ifdef LAP_SPLIT_RECEIVERS
+        #ifndef USE_DIVERSITY
+            #error "LAP_SPLIT_RECEIVERS needs USE_DIVERSITY"
+        #endif
+        #ifdef USE_SCOUT
+            #error "LAP_SPLIT_RECEIVERS and USE_SCOUT both tune receiver B"
+        #endif
+    #endif
+#endif
+
 #ifdef USE_VOLTAGE_MONITORING
     // Voltage monitoring
     // you can use any arduino analog input to measure battery voltage
@@ -101,11 +219,8 @@ SOFTWARE.
     //           R2 = 3.3k |    |
     //    BAT- ----====----|----|
 
-    #ifdef TVOUT_SCREENS
-        #define VBAT_PIN A4
-    #else
-        #define VBAT_PIN A2
-    #endif
+    // A4 on TV out receivers, it is the I2C data line on OLED receivers.
+    #define VBAT_PIN (isTVOut() ? A4 : A2)
 
     // these are default values
     #define WARNING_VOLTAGE 108 // 3.6V per cell for 3S
@@ -131,21 +246,109 @@ SOFTWARE.
 // Buzzer
 #define buzzer 6
 
-// key debounce delay in ms
-// NOTE: good values are in the range of 100-200ms
+// ms a button has to be stable after the last bounce
+// NOTE: good values are in the range of 10-50ms
 // shorter values will make it more reactive, but may lead to double trigger
-#define KEY_DEBOUNCE 200
+#define BUTTON_DEBOUNCE_TIME 20
+// ms held for a long press
+#define BUTTON_LONG_TIME 1000
+// held buttons repeat after BUTTON_REPEAT_DELAY ms, BUTTON_REPEAT_TIME ms
+// apart at first and a quarter faster every repeat down to BUTTON_REPEAT_MIN.
+#define BUTTON_REPEAT_DELAY 400
+#define BUTTON_REPEAT_TIME 150
+#define BUTTON_REPEAT_MIN 30
+
+#ifdef USE_TRACE
+    #define TRACE_EVENTS 48 // 5 bytes of ram each
+    #define TRACE_STALL_TIME 100 // ms without a loop that are traced as a stall
+    #define TRACE_DUMP_COMMAND 'T'
+#endif
+
+#ifdef USE_BENCHMARK
+    #define BENCH_RUNS 32
+    #define BENCH_EEPROM_RUNS 4 // every run wears the EEPROM
+#endif
+
+#ifdef USE_HW_REPROBE
+    #define HW_REPROBE_TIME 2000 // ms
+#endif
 
 #define led 13
 // number of analog rssi reads to average for the current check.
 #define RSSI_READS 50
+#ifdef USE_ADAPTIVE_READS
+    // the read count above is the most, this the least
+    #define RSSI_MIN_READS 8
+    // standard error of the average to stop at, in adc steps
+    #define RSSI_TARGET_ERROR 1
+#endif
+#ifdef USE_RSSI_FILTER
+    #define RSSI_FILTER_MEAN 0    // plain average of all reads
+    #define RSSI_FILTER_MEDIAN 1  // median of every 5 reads
+    #define RSSI_FILTER_TRIMMED 2 // mean of the middle 3 of every 5 reads
+    #define RSSI_FILTER_WINDOW 5
+    // manual and seek mode, decides the receiver
+    #define RSSI_DIVERSITY_FILTER RSSI_FILTER_MEDIAN
+    // band scan and rssi setup
+    #define RSSI_SCAN_FILTER RSSI_FILTER_TRIMMED
+#endif
+#ifdef USE_RSSI_12BIT
+    #define RSSI_EXTRA_BITS 2 // 10 bit adc, 12 bit average
+    #define RSSI_FINE 10 // steps per percent
+#else
+    #define RSSI_EXTRA_BITS 0
+    #define RSSI_FINE 1
+#endif
+#if defined(USE_SLEEP_STATS) && !defined(USE_SLEEP)
+    #error "USE_SLEEP_STATS needs USE_SLEEP"
+#endif
+#if defined(USE_IR_EMITTER) || defined(USE_LAP_TIMER) || defined(USE_ADC_SELF_TEST) || defined(USE_SLEEP_STATS) || defined(USE_INSTRUMENTS) || defined(USE_TRACE) || defined(USE_BENCHMARK)
+    #define USE_SERIAL
+#endif
+
+// ADC clock is 16MHz / ADC_PRESCALER, 16, 32, 64 or 128 (arduino default).
+// A read takes about 13 ADC clocks plus some overhead, 112us at 128.
+#define ADC_PRESCALER 128
+// throw away the first read after switching between the rssi pins, the
+// sample and hold may not follow at fast prescalers.
+//#define ADC_DISCARD_FIRST
+// ADC reference in mV, 5000 (AVcc, arduino default) or 1100 (internal).
+// The rssi output of the module stays below about 1.1V, the internal
+// reference gives it 4.5 times the steps but clips a very strong signal.
+// Run the rssi setup again after changing it.
+#define ADC_REFERENCE 5000
+#if ADC_REFERENCE != 5000 && ADC_REFERENCE != 1100
+    #error "ADC_REFERENCE is 5000 or 1100"
+#endif
+#if ADC_REFERENCE != 5000 && defined(USE_VOLTAGE_MONITORING)
+    #error "the battery divider needs ADC_REFERENCE 5000"
+#endif
 // RSSI default raw range
-#define RSSI_MIN_VAL 90
-#define RSSI_MAX_VAL 220
+#define RSSI_MIN_VAL (90 * 5000L / ADC_REFERENCE)
+#define RSSI_MAX_VAL (220 * 5000L / ADC_REFERENCE)
 // 75% threshold, when channel is printed in spectrum
 #define RSSI_SEEK_FOUND 75
 // 80% under max value for RSSI
 #define RSSI_SEEK_TRESHOLD 80
+#ifdef USE_GUIDED_SEEK
+    // channels checked after the sweep
+    #define SEEK_CANDIDATES 4
+    // settle time per channel during the sweep (ms), the rssi only has to be good enough to rank the channels.
+    #define SEEK_SWEEP_TUNE_TIME 10
+    // readings above rssi_seek_threshold in a row to lock
+    #define SEEK_CONFIRM 2
+#endif
+#ifdef USE_TWO_PASS_SCAN
+    // rssi reads per receiver in the coarse and the fine pass, up to 64.
+    // With USE_RSSI_FILTER they are rounded up to whole windows.
+    #define SCAN_COARSE_READS 8
+    #define SCAN_FINE_READS 64
+    // channels this far above the quietest channel are measured again
+    #define SCAN_NOISE_MARGIN 5
+    #if SCAN_FINE_READS > 64
+        #error "more than 64 reads overflow the rssi sum"
+    #endif
+#endif
 // scan loops for setup run
 #define RSSI_SETUP_RUN 3
 
@@ -161,6 +364,9 @@ SOFTWARE.
 #define STATE_RSSI_SETUP 7
 #define STATE_SCREEN_SAVER 8
 #define STATE_VOLTAGE 9
+#ifdef USE_INSTRUMENTS
+    #define STATE_INSTRUMENTS 10
+#endif
 
 // Seconds to wait before force entering screensaver
 #define SCREENSAVER_TIMEOUT 30
@@ -211,11 +417,6 @@ SOFTWARE.
     #define EEPROM_ADR_RSSI_MIN_B_H 8
     #define EEPROM_ADR_RSSI_MAX_B_L 9
     #define EEPROM_ADR_RSSI_MAX_B_H 10
-
-    // used to figure out if diversity module has been plugged in.
-    // When RSSI is plugged in the min value is around 90
-    // When RSSI is not plugged in the min value is 0
-    #define isDiversity() (analogRead(rssiPinB) >= 5)
 #endif
 
 #define EEPROM_ADR_BEEP 11
@@ -0,0 +1,130 @@
+/*
+ * Simulator benchmarks by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include "settings.h"
+
+#ifdef USE_SIMBENCH
+#include "simbench.h"
+#include "screens.h"
+#include "channels.h"
+
+#define SIMBENCH_SEEK_LOOPS 500 // gives up without a lock
+#define SIMBENCH_FRAMES 50
+#define SIMBENCH_READS 200
+
+// main project
+extern screens drawScreen;
+extern uint8_t state;
+extern uint8_t active_receiver;
+extern uint8_t seek_found;
+extern uint8_t first_tune;
+extern char call_sign[];
+void setChannelModule(uint8_t channel);
+uint16_t readRSSI();
+void loop();
+
+static void sweep() {
+    for(uint8_t position = CHANNEL_MIN; position <= CHANNEL_MAX; position++) {
+        uint8_t index = pgm_read_byte_near(channelList + position);
+        setChannelModule(index);
+        uint8_t value = readRSSI();
+        drawScreen.updateBandScanMode(false, position, value, pgm_read_byte_near(channelNames + index), pgm_read_word_near(channelFreqTable + index), RSSI_MIN_VAL, RSSI_MAX_VAL);
+    }
+}
+
+static uint8_t seekToLock() {
+    seek_found = 0;
+    for(uint16_t i = 0; i < SIMBENCH_SEEK_LOOPS && !seek_found; i++) {
+        loop();
+    }
+    return seek_found;
+}
+
+static void screenSaverFrames() {
+    for(uint8_t frame = 0; frame < SIMBENCH_FRAMES; frame++) {
+        uint8_t value = 1 + frame*2;
+#ifdef USE_DIVERSITY
+        drawScreen.updateScreenSaver(active_receiver, value, value, 100-value);
+#else
+        drawScreen.updateScreenSaver(value);
+#endif
+    }
+}
+
+static uint8_t diversitySwitches() {
+    uint8_t switches = 0;
+    uint8_t receiver = active_receiver;
+    for(uint8_t i = 0; i < SIMBENCH_READS; i++) {
+        readRSSI();
+        if(active_receiver != receiver) {
+            receiver = active_receiver;
+            switches++;
+        }
+    }
+    return switches;
+}
+
+static void mark(uint8_t scenario, uint8_t result) {
+    GPIOR1 = result;
+    GPIOR0 = scenario;
+}
+
+void simbenchRun() {
+    first_tune = 0; // no boot beeps in the seek
+
+    state = STATE_SCAN;
+    drawScreen.bandScanMode(STATE_SCAN);
+    mark(SIMBENCH_SWEEP, 0);
+    sweep();
+    mark(0, 0);
+
+    state = STATE_SEEK;
+    mark(SIMBENCH_SEEK, 0);
+    uint8_t locked = seekToLock();
+    mark(0, locked);
+
+#ifdef USE_DIVERSITY
+    drawScreen.screenSaver(useReceiverAuto, pgm_read_byte_near(channelNames), pgm_read_word_near(channelFreqTable), call_sign);
+#else
+    drawScreen.screenSaver(pgm_read_byte_near(channelNames), pgm_read_word_near(channelFreqTable), call_sign);
+#endif
+    mark(SIMBENCH_SCREENSAVER, 0);
+    screenSaverFrames();
+    mark(0, 0);
+
+    state = STATE_MANUAL;
+    mark(SIMBENCH_DIVERSITY, 0);
+    uint8_t switches = diversitySwitches();
+    mark(0, switches);
+
+    mark(SIMBENCH_DONE, 0);
+    cli();
+    sleep_enable();
+    sleep_cpu(); // simavr stops here
+}
+#endif
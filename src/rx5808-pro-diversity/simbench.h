@@ -0,0 +1,46 @@
+/*
+ * Simulator benchmarks by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef simbench_h
+#define simbench_h
+
+// Simulator benchmarks
+// Built by tools/simbench/simbench.py with -DUSE_SIMBENCH and run under
+// simavr. After setup the scenarios below run one after the other, the
+// scenario id written to GPIOR0 marks its start and 0 its end, GPIOR1
+// holds a result for the harness. The harness counts the cycles between
+// the marks, feeds the rssi inputs and watches the stack.
+
+// scenario ids, keep tools/simbench/simbench.c in sync
+#define SIMBENCH_SWEEP 1       // tune, read and draw all channels
+#define SIMBENCH_SEEK 2        // seek mode loops until a lock, result 1 if locked
+#define SIMBENCH_SCREENSAVER 3 // screen saver frames
+#define SIMBENCH_DIVERSITY 4   // rssi reads, result the receiver switches
+#define SIMBENCH_DONE 0xFF     // the CPU sleeps with interrupts off next
+
+void simbenchRun();
+
+#endif
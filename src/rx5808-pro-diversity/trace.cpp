@@ -0,0 +1,121 @@
+/*
+ * Event trace by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+
+#ifdef USE_TRACE
+#include "trace.h"
+
+struct traceEvent {
+    uint16_t time; // low bits of millis()
+    uint8_t type;
+    uint8_t a;
+    uint8_t b;
+};
+
+static traceEvent trace_events[TRACE_EVENTS];
+static uint8_t trace_next = 0; // slot of the next event
+static uint8_t trace_count = 0;
+static unsigned long trace_time = 0; // of the last event
+static unsigned long trace_loop_time = 0;
+
+static void traceAdd(unsigned long time, uint8_t type, uint8_t a, uint8_t b) {
+    traceEvent *event = &trace_events[trace_next];
+    event->time = time;
+    event->type = type;
+    event->a = a;
+    event->b = b;
+    trace_next = (trace_next + 1) % TRACE_EVENTS;
+    if(trace_count < TRACE_EVENTS) {
+        trace_count++;
+    }
+    trace_time = time;
+}
+
+void trace(uint8_t type, uint8_t a, uint8_t b) {
+    unsigned long now = millis();
+    if(trace_count && now - trace_time > 0xFFFF) {
+        // the 16 bit times can not tell the gap, an idle event counts it
+        uint16_t periods = (now - trace_time) >> 16;
+        traceAdd(trace_time + ((unsigned long)periods << 16), TRACE_IDLE, lowByte(periods), highByte(periods));
+    }
+    if(type == TRACE_FLUSH && trace_count) {
+        // flushes in a row share one event
+        traceEvent *last = &trace_events[(trace_next + TRACE_EVENTS - 1) % TRACE_EVENTS];
+        if(last->type == TRACE_FLUSH) {
+            if(last->a < 255) {
+                last->a++;
+            }
+            if(b > last->b) {
+                last->b = b;
+            }
+            return;
+        }
+    }
+    traceAdd(now, type, a, b);
+}
+
+void traceLoop() {
+    unsigned long now = millis();
+    unsigned long stall = now - trace_loop_time;
+    if(trace_loop_time && stall >= TRACE_STALL_TIME) {
+        stall = stall > 0xFFFF ? 0xFFFF : stall;
+        trace(TRACE_STALL, lowByte(stall), highByte(stall));
+    }
+    trace_loop_time = now;
+    if(Serial.available() && Serial.read() == TRACE_DUMP_COMMAND) {
+        traceDump();
+    }
+}
+
+static void printHex(uint8_t value) {
+    Serial.print(value >> 4, HEX);
+    Serial.print(value & 0x0F, HEX);
+}
+
+void traceDump() {
+    Serial.print(F("TRACE "));
+    Serial.print(millis());
+    Serial.print(' ');
+    Serial.print(trace_time);
+    Serial.print(' ');
+    Serial.println(trace_count);
+    uint8_t slot = (trace_next + TRACE_EVENTS - trace_count) % TRACE_EVENTS;
+    for(uint8_t i = 0; i < trace_count; i++) {
+        traceEvent *event = &trace_events[slot];
+        printHex(highByte(event->time));
+        printHex(lowByte(event->time));
+        printHex(event->type);
+        printHex(event->a);
+        printHex(event->b);
+        Serial.println();
+        slot = (slot + 1) % TRACE_EVENTS;
+    }
+    Serial.println(F("END"));
+    trace_loop_time = millis(); // sending is not a stall
+}
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Event trace by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef trace_h
+#define trace_h
+
+#include <stdint.h>
+#include "settings.h"
+
+// Event trace
+// The last TRACE_EVENTS events are kept in a ring buffer, 5 bytes each
+// with the low 16 bits of millis(). traceDump() sends them over serial as
+// hex lines, tools/trace_decode.py turns a dump into a timeline.
+//
+//   TRACE <now> <time of last event> <count>
+//   ttttyyaabb (one line per event, oldest first)
+//   END
+
+// event types, keep tools/trace_decode.py in sync
+#define TRACE_BOOT 0x01     // a: state
+#define TRACE_STATE 0x02    // a: new state, b: old state
+#define TRACE_TUNE 0x03     // a: channel name, b: receivers, 1 A, 2 B, 3 both
+#define TRACE_SWITCH_A 0x04 // a: rssi A, b: rssi B in percent
+#define TRACE_SWITCH_B 0x05 // a: rssi A, b: rssi B in percent
+#define TRACE_LOCK 0x06     // a: channel name, b: rssi
+#define TRACE_FLUSH 0x07    // a: display flushes in a row, b: longest in ms
+#define TRACE_STALL 0x08    // a, b: ms the loop did not run, low byte first
+#define TRACE_IDLE 0x09     // a, b: 65536ms periods without events, low byte first
+
+#ifdef USE_TRACE
+void trace(uint8_t type, uint8_t a, uint8_t b);
+// checks for loop stalls and the dump command, call once per loop.
+void traceLoop();
+void traceDump();
+
+#define TRACE(type, a, b) trace(type, a, b)
+#else
+#define TRACE(type, a, b)
+#endif
+
+#endif
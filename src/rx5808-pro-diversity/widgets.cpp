@@ -0,0 +1,259 @@
+/*
+ * Widgets for the Screens Class by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h>
+#include "settings.h"
+#include "widgets.h"
+#include "instruments.h"
+
+#define WIDGET_NONE 0
+#define WIDGET_LABEL 1
+#define WIDGET_NUMBER 2
+#define WIDGET_BAR 3
+#define WIDGET_MARKER 4
+#define WIDGET_LIST 5
+
+widget widgets[WIDGET_COUNT];
+
+const char channelItem1[] PROGMEM = "1";
+const char channelItem2[] PROGMEM = "2";
+const char channelItem3[] PROGMEM = "3";
+const char channelItem4[] PROGMEM = "4";
+const char channelItem5[] PROGMEM = "5";
+const char channelItem6[] PROGMEM = "6";
+const char channelItem7[] PROGMEM = "7";
+const char channelItem8[] PROGMEM = "8";
+const char * const channelItems[] PROGMEM = {
+    channelItem1, channelItem2, channelItem3, channelItem4,
+    channelItem5, channelItem6, channelItem7, channelItem8
+};
+
+#ifdef USE_INSTRUMENTS
+uint16_t widget_draws = 0;
+uint16_t widget_skips = 0;
+unsigned long widget_draw_time = 0;
+#endif
+
+// forget everything that is on screen, called when a screen is cleared.
+void widgetsReset() {
+    for(uint8_t i=0; i<WIDGET_COUNT; i++) {
+        widgets[i].place(WIDGET_NONE, 0, 0, 0, 0, 0);
+    }
+}
+
+void widget::place(uint8_t type, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style) {
+    this->type = type;
+    this->x = x;
+    this->y = y;
+    this->w = w;
+    this->h = h;
+    this->style = (style & WIDGET_STATIC) | WIDGET_STALE;
+    this->value = 0;
+    this->data = 0;
+}
+
+void widget::label(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style) {
+    place(WIDGET_LABEL, x, y, w, h, style);
+}
+
+void widget::number(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style) {
+    place(WIDGET_NUMBER, x, y, w, h, style);
+}
+
+// w/h is the full size of the bar, value is the filled length in pixels.
+void widget::bar(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style) {
+    place(WIDGET_BAR, x, y, w, h, style);
+}
+
+// w/h is the size of the marker, value is the offset from x (or y if vertical).
+void widget::marker(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style) {
+    place(WIDGET_MARKER, x, y, w, h, style);
+}
+
+// w/h is the size of one item, items are step pixels apart.
+void widget::list(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t step, const char * const *items, uint8_t count, uint8_t style) {
+    place(WIDGET_LIST, x, y, w, h, style);
+    this->step = step;
+    this->count = count;
+    this->data = items;
+}
+
+bool widget::update(uint16_t new_value, uint8_t flags) {
+    uint8_t new_style = (style & WIDGET_STATIC) | flags;
+    if(type == WIDGET_NONE || (!(style & WIDGET_STALE) && new_value == value && new_style == style)) {
+        INSTR_ADD(widget_skips, 1);
+        return false;
+    }
+#ifdef USE_INSTRUMENTS
+    unsigned long start = micros();
+#endif
+    uint16_t last_value = value;
+    bool full = (style & WIDGET_STALE) || new_style != style;
+    value = new_value;
+    style = new_style;
+    if(full) {
+        draw();
+    }
+    else {
+        drawChange(last_value);
+    }
+    INSTR_ADD(widget_draws, 1);
+    INSTR_ADD(widget_draw_time, micros() - start);
+    return true;
+}
+
+void widget::invalidate() {
+    style |= WIDGET_STALE;
+}
+
+bool widget::update(const char *text, uint8_t flags) {
+    if(text != data) {
+        data = text;
+        style |= WIDGET_STALE;
+    }
+    return update((uint16_t)0, flags);
+}
+
+void widget::draw() {
+    char text[WIDGET_TEXT_SIZE];
+    style &= ~WIDGET_STALE;
+    switch(type) {
+        case WIDGET_LABEL:
+            if(data) {
+                strncpy_P(text, (const char *)data, sizeof(text)-1);
+                text[sizeof(text)-1] = '\0';
+            }
+            else {
+                text[0] = '\0';
+            }
+            widgetText(x, y, w, h, text, style);
+            break;
+        case WIDGET_NUMBER:
+            numFormat(text, value, style & (NUM_HEX|NUM_DECIMAL));
+            widgetText(x, y, w, h, text, style);
+            break;
+        case WIDGET_BAR:
+            widgetFillRect(x, y, w, h, WIDGET_BLACK);
+            if(style & WIDGET_OUTLINE) {
+                if(value) {
+                    if(style & WIDGET_VERTICAL) {
+                        widgetDrawRect(x, y+h-value, w, value, WIDGET_WHITE);
+                    }
+                    else {
+                        widgetDrawRect(x, y, value, h, WIDGET_WHITE);
+                    }
+                }
+            }
+            else {
+                drawBar(0, value, WIDGET_WHITE);
+            }
+            break;
+        case WIDGET_MARKER:
+            drawMarker(value, WIDGET_WHITE);
+            return;
+        case WIDGET_LIST:
+            for(uint8_t i=0; i<count; i++) {
+                drawItem(i);
+            }
+            return;
+    }
+    widgetInvalidate(x, y, w, h);
+}
+
+// only draw what differs from the last value.
+void widget::drawChange(uint16_t last_value) {
+    switch(type) {
+        case WIDGET_BAR:
+            if(style & WIDGET_OUTLINE) {
+                // the frame moves with the value, the delta can not be filled
+                draw();
+            }
+            else if(value > last_value) {
+                drawBar(last_value, value, WIDGET_WHITE);
+            }
+            else {
+                drawBar(value, last_value, WIDGET_BLACK);
+            }
+            break;
+        case WIDGET_MARKER:
+            drawMarker(last_value, WIDGET_BLACK);
+            drawMarker(value, WIDGET_WHITE);
+            break;
+        case WIDGET_LIST:
+            if(last_value < count) {
+                drawItem(last_value);
+            }
+            drawItem(value);
+            break;
+        default:
+            draw();
+    }
+}
+
+void widget::drawBar(uint8_t from, uint8_t to, uint8_t color) {
+    if(style & WIDGET_VERTICAL) {
+        to = to > h ? h : to;
+        from = from > to ? to : from;
+        widgetFillRect(x, y+h-to, w, to-from, color);
+        widgetInvalidate(x, y+h-to, w, to-from);
+    }
+    else {
+        to = to > w ? w : to;
+        from = from > to ? to : from;
+        widgetFillRect(x+from, y, to-from, h, color);
+        widgetInvalidate(x+from, y, to-from, h);
+    }
+}
+
+void widget::drawMarker(uint16_t position, uint8_t color) {
+    if(style & WIDGET_VERTICAL) {
+        widgetFillRect(x, y+position, w, h, color);
+        widgetInvalidate(x, y+position, w, h);
+    }
+    else {
+        widgetFillRect(x+position, y, w, h, color);
+        widgetInvalidate(x+position, y, w, h);
+    }
+}
+
+void widget::drawItem(uint8_t index) {
+    char text[WIDGET_TEXT_SIZE];
+    if(index >= count) {
+        return;
+    }
+    uint8_t item_x = x;
+    uint8_t item_y = y;
+    if(style & WIDGET_VERTICAL) {
+        item_y += index*step;
+    }
+    else {
+        item_x += index*step;
+    }
+    strncpy_P(text, (const char *)pgm_read_word((const char * const *)data + index), sizeof(text)-1);
+    text[sizeof(text)-1] = '\0';
+    widgetText(item_x, item_y, w, h, text, (style & WIDGET_CENTER) | (index == value ? WIDGET_INVERT : 0));
+    widgetInvalidate(item_x, item_y, w, h);
+}
@@ -0,0 +1,170 @@
+/*
+ * Widgets for the Screens Class by Shea Ivey
+
+The MIT License (MIT)
+
+Copyright (c) 2015 Shea Ivey
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef widgets_h
+#define widgets_h
+
+#include <avr/pgmspace.h>
+#include "screens.h"
+#include "numfmt.h"
+
+// Retained widgets
+// Each widget remembers the value it has drawn last and only touches the
+// display when update() is called with something different.
+// The screens backends position the widgets when a screen is entered and
+// implement the drawing hooks below with their own display library.
+
+#define WIDGET_BLACK 0
+#define WIDGET_WHITE 1
+
+// static style, set when the widget is placed
+#define WIDGET_VERTICAL 0x01 // bars grow upwards, markers and lists run top to bottom
+#define WIDGET_CENTER   0x02 // center text in the widget box
+#define WIDGET_HEX      0x04 // numbers printed as hex
+#define WIDGET_DECIMAL  0x08 // numbers are in tenths, printed with one decimal
+#define WIDGET_STATIC   0x0F
+
+// dynamic flags, passed with every update
+#define WIDGET_INVERT   0x10 // text black on white
+#define WIDGET_OUTLINE  0x20 // bars only draw a frame around the value
+#define WIDGET_STALE    0x80 // cached value not on screen yet
+
+// a widget pool is shared by all screens, only one screen is visible at a time.
+#define WIDGET_COUNT 8
+
+// widget slots used by the screens
+#define WIDGET_SEEK_TITLE 0
+#define WIDGET_SEEK_BAND 1
+#define WIDGET_SEEK_CHANNELS 2
+#define WIDGET_SEEK_FREQUENCY 3
+#define WIDGET_SEEK_RSSI 4
+#define WIDGET_SEEK_THRESHOLD_LEFT 5
+#define WIDGET_SEEK_THRESHOLD_RIGHT 6
+#define WIDGET_SEEK_MARKER 7
+
+#define WIDGET_SCAN_NAME 0
+#define WIDGET_SCAN_FREQUENCY 1
+#define WIDGET_SCAN_MIN 2
+#define WIDGET_SCAN_MAX 3
+#define WIDGET_SCAN_MARKER 4
+
+#define WIDGET_RSSI_A 0
+#define WIDGET_RSSI_B 1
+#define WIDGET_RSSI 2
+#define WIDGET_LOW_SIGNAL 3
+
+// longest text a widget can show
+#define WIDGET_TEXT_SIZE 22
+
+class widget
+{
+    private:
+        uint8_t type;
+        uint8_t style;
+        uint8_t step;  // list item spacing
+        uint8_t count; // list item count
+        uint16_t value;
+        const void *data; // PROGMEM label text or list item table
+
+        void place(uint8_t type, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style);
+        void drawChange(uint16_t last_value);
+        void drawBar(uint8_t from, uint8_t to, uint8_t color);
+        void drawMarker(uint16_t position, uint8_t color);
+        void drawItem(uint8_t index);
+        friend void widgetsReset();
+
+    public:
+        uint8_t x, y, w, h;
+
+        // placement, the widget is drawn on the first update.
+        void label(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style);
+        void number(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style);
+        void bar(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style);
+        void marker(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t style);
+        void list(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t step, const char * const *items, uint8_t count, uint8_t style);
+
+        // returns true if the widget had to be redrawn.
+        bool update(uint16_t value, uint8_t flags = 0); // number, bar length, marker offset or list selection
+        bool update(const char *text, uint8_t flags = 0); // label, PROGMEM text
+        void draw(); // redraw from the cached value
+        void invalidate(); // redraw on the next update, something was drawn over the widget
+};
+
+extern widget widgets[WIDGET_COUNT];
+void widgetsReset();
+
+// "1" to "8" for channel lists
+extern const char * const channelItems[] PROGMEM;
+
+#ifdef USE_INSTRUMENTS
+// drawing statistics
+extern uint16_t widget_draws;
+extern uint16_t widget_skips;
+extern unsigned long widget_draw_time; // us
+#endif
+
+// Drawing hooks, implemented by every screens backend for its display.
+// Text is drawn opaque inside the box x,y,w,h.
+template<uint8_t display> struct widgetHooks
+{
+    static void fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color);
+    static void drawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color);
+    static void text(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const char *text, uint8_t style);
+    // called with the area a widget has drawn to.
+    static void invalidate(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+};
+
+// declared up front, the calls below must not instantiate the empty template.
+#define WIDGET_HOOKS(display) \
+    template<> void widgetHooks<display>::fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color); \
+    template<> void widgetHooks<display>::drawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color); \
+    template<> void widgetHooks<display>::text(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const char *text, uint8_t style); \
+    template<> void widgetHooks<display>::invalidate(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+WIDGET_HOOKS(DISPLAY_TVOUT)
+WIDGET_HOOKS(DISPLAY_OLED_ADAFRUIT)
+WIDGET_HOOKS(DISPLAY_OLED_U8G)
+WIDGET_HOOKS(DISPLAY_OLED_SSD1306)
+
+#ifdef AUTO_SCREENS
+    #define WIDGET_HOOK(call) (screens_display == DISPLAY_TVOUT ? widgetHooks<DISPLAY_TVOUT>::call : widgetHooks<DISPLAY_OLED_SSD1306>::call)
+#else
+    #define WIDGET_HOOK(call) widgetHooks<SCREENS_DISPLAY>::call
+#endif
+
+inline void widgetFillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    WIDGET_HOOK(fillRect(x, y, w, h, color));
+}
+inline void widgetDrawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    WIDGET_HOOK(drawRect(x, y, w, h, color));
+}
+inline void widgetText(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const char *text, uint8_t style) {
+    WIDGET_HOOK(text(x, y, w, h, text, style));
+}
+inline void widgetInvalidate(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    WIDGET_HOOK(invalidate(x, y, w, h));
+}
+
+#endif
@@ -0,0 +1,24 @@
+// Host stand-in for the Adafruit GFX library, drawing does nothing.
+#pragma once
+#include <Arduino.h>
+
+#define BLACK 0
+#define WHITE 1
+#define INVERSE 2
+
+class Adafruit_GFX : public Print
+{
+    public:
+        void drawPixel(int16_t x, int16_t y, uint16_t color) {}
+        void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {}
+        void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {}
+        void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {}
+        void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {}
+        void setCursor(int16_t x, int16_t y) {}
+        void setTextColor(uint16_t color) {}
+        void setTextColor(uint16_t color, uint16_t background) {}
+        void setTextSize(uint8_t size) {}
+        void setRotation(uint8_t rotation) {}
+        int16_t width() { return 128; }
+        int16_t height() { return 64; }
+};
@@ -0,0 +1,15 @@
+// Host stand-in for the Adafruit SH1106 library.
+#pragma once
+#include <Adafruit_GFX.h>
+
+#define SH1106_128_64
+#define SH1106_SWITCHCAPVCC 2
+
+class Adafruit_SH1106 : public Adafruit_GFX
+{
+    public:
+        Adafruit_SH1106(int8_t reset) {}
+        void begin(uint8_t vcc, uint8_t address) {}
+        void display() {}
+        void clearDisplay() {}
+};
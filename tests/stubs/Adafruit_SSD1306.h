@@ -0,0 +1,15 @@
+// Host stand-in for the Adafruit SSD1306 library.
+#pragma once
+#include <Adafruit_GFX.h>
+
+#define SSD1306_128_64
+#define SSD1306_SWITCHCAPVCC 2
+
+class Adafruit_SSD1306 : public Adafruit_GFX
+{
+    public:
+        Adafruit_SSD1306(int8_t reset) {}
+        void begin(uint8_t vcc, uint8_t address) {}
+        void display() {}
+        void clearDisplay() {}
+};
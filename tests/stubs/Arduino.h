@@ -0,0 +1,108 @@
+// Host stand-in for the Arduino core. Time, pins and the ADC are driven by
+// the tests through stubs.h, Serial output is kept in a string.
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define DEFAULT 1
+#define INTERNAL 3
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+#define SDA 18
+#define SCL 19
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define digitalPinToPCICR(p) (&PCICR)
+#define digitalPinToPCICRbit(p) (((p) <= 7) ? 2 : (((p) <= 13) ? 0 : 1))
+#define digitalPinToPCMSK(p) ((((p) <= 7) ? &PCMSK2 : (((p) <= 13) ? &PCMSK0 : &PCMSK1)))
+#define digitalPinToPCMSKbit(p) (((p) <= 7) ? (p) : (((p) <= 13) ? ((p) - 8) : ((p) - 14)))
+
+template<class T> T min(T a, T b) { return a < b ? a : b; }
+template<class T> T max(T a, T b) { return a > b ? a : b; }
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogReference(uint8_t mode);
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long max);
+long random(long min, long max);
+void noInterrupts();
+void interrupts();
+
+class __FlashStringHelper;
+#define F(string) ((const __FlashStringHelper *)(string))
+
+// number formatting like the Arduino Print class
+class Print
+{
+    private:
+        size_t printNumber(unsigned long n, uint8_t base);
+
+    public:
+        virtual ~Print() {}
+        virtual size_t write(uint8_t c) { return 1; }
+        size_t write(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+        size_t write(const uint8_t *buffer, size_t size);
+
+        size_t print(const __FlashStringHelper *text) { return write((const char *)text); }
+        size_t print(const char *text) { return write(text); }
+        size_t print(char c) { return write((uint8_t)c); }
+        size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+        size_t print(int n, int base = DEC) { return print((long)n, base); }
+        size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+        size_t print(long n, int base = DEC);
+        size_t print(unsigned long n, int base = DEC);
+        size_t print(double n, int digits = 2);
+
+        size_t println() { return write("\r\n"); }
+        template<class T> size_t println(T value) { size_t n = print(value); return n + println(); }
+        template<class T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+class HardwareSerial : public Print
+{
+    public:
+        void begin(unsigned long baud) {}
+        int available();
+        int read();
+        void flush() {}
+        virtual size_t write(uint8_t c);
+        using Print::write;
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,12 @@
+// Host stand-in for the EEPROM library, backed by stub_eeprom.
+#pragma once
+#include <stdint.h>
+
+struct EEPROMClass
+{
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    void update(int address, uint8_t value) { write(address, value); }
+};
+
+extern EEPROMClass EEPROM;
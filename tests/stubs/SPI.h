@@ -0,0 +1,2 @@
+// Host stand-in for <SPI.h>, nothing is used from it.
+#pragma once
@@ -0,0 +1,39 @@
+// Host stand-in for the TVout library, drawing does nothing.
+#pragma once
+#include <Arduino.h>
+
+#define PAL 1
+#define NTSC 0
+#define WHITE 1
+#define BLACK 0
+#define INVERT 2
+#define BYTE 0
+
+class TVout : public Print
+{
+    public:
+        char begin(uint8_t mode, uint8_t x, uint8_t y) { return 0; }
+        void end() {}
+        void fill(uint8_t color) {}
+        void select_font(const unsigned char *font) {}
+        void draw_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, char color) {}
+        void draw_row(uint8_t line, uint16_t x0, uint16_t x1, uint8_t color) {}
+        void draw_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, char color, char fill = -1) {}
+        void set_pixel(uint8_t x, uint8_t y, char color) {}
+        void bitmap(uint8_t x, uint8_t y, const unsigned char *bmp, uint16_t i = 0, uint8_t width = 0, uint8_t lines = 0) {}
+        void set_cursor(uint8_t x, uint8_t y) {}
+        void print_char(uint8_t x, uint8_t y, unsigned char c) {}
+        void printPGM(const char *text) {}
+        void printPGM(uint8_t x, uint8_t y, const char *text) {}
+        using Print::print;
+        void print(uint8_t x, uint8_t y, const char *text) {}
+        void print(uint8_t x, uint8_t y, char c, int base = BYTE) {}
+        void print(uint8_t x, uint8_t y, unsigned char c, int base = BYTE) {}
+        void print(uint8_t x, uint8_t y, int n, int base = DEC) {}
+        void print(uint8_t x, uint8_t y, unsigned int n, int base = DEC) {}
+        void print(uint8_t x, uint8_t y, long n, int base = DEC) {}
+        void print(uint8_t x, uint8_t y, unsigned long n, int base = DEC) {}
+        void print(uint8_t x, uint8_t y, double n, int digits = 2) {}
+};
+
+#define clear_screen() fill(0)
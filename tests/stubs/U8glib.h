@@ -0,0 +1,88 @@
+// Host stand-in for u8glib. The page loop works like the real one, the
+// internals the u8g screens use are the same: the page buffer hangs off
+// dev_mem, setRot180() puts a rotation device in front of it and the page
+// box is mirrored. Every page sent to the controller goes to
+// stub_u8g_pages, drawing does nothing.
+#pragma once
+#include <Arduino.h>
+
+typedef uint8_t u8g_uint_t;
+typedef uint8_t u8g_pgm_uint8_t;
+
+struct u8g_page_t { u8g_uint_t page_height, total_height, page_y0, page_y1; uint8_t page; };
+struct u8g_pb_t { u8g_page_t p; u8g_uint_t width; void *buf; };
+struct u8g_dev_t { void *dev_fn; void *dev_mem; void *com_fn; };
+struct u8g_box_t { u8g_uint_t x0, y0, x1, y1; };
+struct u8g_t { u8g_dev_t *dev; u8g_box_t current_page; };
+
+extern "C" {
+    uint8_t u8g_page_Next(u8g_page_t *p);
+    void u8g_GetPageBox(u8g_t *u8g, u8g_box_t *box);
+    void u8g_FirstPage(u8g_t *u8g);
+    uint8_t u8g_NextPage(u8g_t *u8g);
+    void u8g_pb_Clear(u8g_pb_t *pb);
+    extern uint8_t u8g_dev_rot180_fn; // marks the rotation device
+}
+
+extern const uint8_t u8g_font_fixed_v0[];
+extern const uint8_t u8g_font_6x10[];
+extern const uint8_t u8g_font_5x8[];
+extern const uint8_t u8g_font_10x20[];
+extern const uint8_t u8g_font_fub30[];
+
+#define U8G_I2C_OPT_NONE 0
+#define U8G_I2C_OPT_DEV_0 1
+#define U8G_I2C_OPT_NO_ACK 2
+#define U8G_I2C_OPT_FAST 4
+
+class U8GLIB : public Print
+{
+    private:
+        u8g_t u8g;
+        u8g_dev_t dev;
+        u8g_dev_t rot;
+        u8g_pb_t pb;
+        uint8_t buffer[128];
+
+    public:
+        U8GLIB();
+        u8g_t *getU8g() { return &u8g; }
+        void firstPage() { u8g_FirstPage(&u8g); }
+        uint8_t nextPage() { return u8g_NextPage(&u8g); }
+        void setRot180();
+        uint8_t begin() { return 1; }
+
+        u8g_uint_t getWidth() { return 128; }
+        u8g_uint_t getHeight() { return 64; }
+        void setFont(const uint8_t *font) {}
+        void setFontRefHeightExtendedText() {}
+        void setFontPosTop() {}
+        void setFontPosBaseline() {}
+        void setDefaultForegroundColor() {}
+        void setColorIndex(uint8_t color) {}
+        int8_t getFontAscent() { return 8; }
+        u8g_uint_t getStrWidth(const char *text) { return strlen(text)*6; }
+
+        void setPrintPos(u8g_uint_t x, u8g_uint_t y) {}
+        u8g_uint_t drawStr(u8g_uint_t x, u8g_uint_t y, const char *text) { return strlen(text)*6; }
+        u8g_uint_t drawStrP(u8g_uint_t x, u8g_uint_t y, const u8g_pgm_uint8_t *text) { return strlen((const char *)text)*6; }
+        void drawPixel(u8g_uint_t x, u8g_uint_t y) {}
+        void drawLine(u8g_uint_t x0, u8g_uint_t y0, u8g_uint_t x1, u8g_uint_t y1) {}
+        void drawHLine(u8g_uint_t x, u8g_uint_t y, u8g_uint_t w) {}
+        void drawVLine(u8g_uint_t x, u8g_uint_t y, u8g_uint_t h) {}
+        void drawBox(u8g_uint_t x, u8g_uint_t y, u8g_uint_t w, u8g_uint_t h) {}
+        void drawFrame(u8g_uint_t x, u8g_uint_t y, u8g_uint_t w, u8g_uint_t h) {}
+        void drawBitmapP(u8g_uint_t x, u8g_uint_t y, u8g_uint_t count, u8g_uint_t h, const uint8_t *bitmap) {}
+};
+
+class U8GLIB_SSD1306_128X64 : public U8GLIB
+{
+    public:
+        U8GLIB_SSD1306_128X64(uint8_t options) {}
+};
+
+class U8GLIB_SH1106_128X64 : public U8GLIB
+{
+    public:
+        U8GLIB_SH1106_128X64(uint8_t options) {}
+};
@@ -0,0 +1,18 @@
+// Host stand-in for the Wire library, every transmission is appended to
+// stub_wire.
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+extern volatile uint8_t TWBR;
+
+struct TwoWire
+{
+    void begin() {}
+    void setClock(unsigned long clock) {}
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t value);
+    uint8_t endTransmission();
+};
+
+extern TwoWire Wire;
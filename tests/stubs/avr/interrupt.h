@@ -0,0 +1,10 @@
+// Host stand-in for <avr/interrupt.h>, an ISR is a plain function the
+// tests call to fire the interrupt.
+#pragma once
+
+#define ISR(vector, ...) extern "C" void vector(void); void vector(void)
+#define ISR_ALIASOF(vector)
+#define EMPTY_INTERRUPT(vector) extern "C" void vector(void); void vector(void) {}
+
+void cli();
+void sei();
@@ -0,0 +1,60 @@
+// Host stand-in for <avr/io.h>, the registers are plain variables.
+#pragma once
+#include <stdint.h>
+
+// setting ADSC converts the ADMUX input right away, ADSC reads back clear
+// as if the conversion had run while the CPU was elsewhere.
+struct StubAdcsra {
+    uint8_t bits;
+    operator uint8_t() const volatile { return bits; }
+    void operator=(uint8_t value) volatile;
+    void operator|=(uint8_t value) volatile { *this = bits | value; }
+    void operator&=(uint8_t value) volatile { *this = bits & value; }
+};
+extern volatile StubAdcsra ADCSRA;
+extern volatile uint8_t ADCSRB, ADMUX, ADCL, ADCH, DIDR0;
+extern volatile uint16_t ADC;
+extern volatile uint8_t PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2;
+extern volatile uint8_t PINB, PINC, PIND, PORTB, PORTC, PORTD, DDRD;
+extern volatile uint8_t TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0, TIFR0;
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+extern volatile uint16_t TCNT1;
+extern volatile uint8_t SMCR, MCUCR, PRR, SREG, TWCR;
+extern volatile uint8_t GPIOR0, GPIOR1, GPIOR2;
+extern volatile uint16_t SP;
+extern uint8_t __heap_start, __bss_end;
+
+#define _BV(b) (1<<(b))
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+#define REFS0 6
+#define REFS1 7
+#define ADLAR 5
+#define MUX0 0
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+#define PCINT18 2
+#define PCINT19 3
+#define PCINT20 4
+#define PCINT21 5
+#define OCIE0A 1
+#define OCIE0B 2
+#define TOV1 0
+#define TOIE1 0
+#define CS10 0
+#define SE 0
+#define SM0 1
+#define SM1 2
+#define SM2 3
+#define RAMSTART 0x100
+#define RAMEND 0x8FF
+#ifndef F_CPU
+#define F_CPU 16000000L
+#endif
@@ -0,0 +1,22 @@
+// Host stand-in for <avr/pgmspace.h>, flash is ordinary memory.
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+
+// tables of pointers are read with pgm_read_word on the AVR, the host
+// pointers do not fit so the read keeps the type of the table.
+template<class T> inline T pgmRead(const T *address) { return *address; }
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_byte_near(address) pgm_read_byte(address)
+#define pgm_read_word(address) pgmRead(address)
+#define pgm_read_word_near(address) pgmRead(address)
+#define pgm_read_ptr(address) pgmRead(address)
+
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define memcpy_P memcpy
@@ -0,0 +1,12 @@
+// Host stand-in for <avr/sleep.h>, sleeping does nothing.
+#pragma once
+#include <stdint.h>
+
+#define SLEEP_MODE_IDLE 0
+#define SLEEP_MODE_ADC 1
+
+inline void set_sleep_mode(uint8_t) {}
+inline void sleep_enable() {}
+inline void sleep_disable() {}
+inline void sleep_cpu() {}
+inline void sleep_mode() {}
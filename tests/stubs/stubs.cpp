@@ -0,0 +1,295 @@
+// Host stand-ins for the Arduino core and the libraries the sketch uses.
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <Wire.h>
+#include <U8glib.h>
+#include "stubs.h"
+
+volatile StubAdcsra ADCSRA;
+volatile uint8_t ADCSRB, ADMUX, ADCL, ADCH, DIDR0;
+volatile uint16_t ADC;
+volatile uint8_t PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2;
+volatile uint8_t PINB, PINC, PIND, PORTB, PORTC, PORTD, DDRD;
+volatile uint8_t TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0, TIFR0;
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+volatile uint16_t TCNT1;
+volatile uint8_t SMCR, MCUCR, PRR, SREG, TWCR, TWBR;
+volatile uint8_t GPIOR0, GPIOR1, GPIOR2;
+volatile uint16_t SP = RAMEND;
+uint8_t __heap_start, __bss_end;
+char *__brkval = NULL;
+
+unsigned long stub_micros = 0;
+uint8_t stub_pins[STUB_PINS];
+uint16_t stub_analog[STUB_PINS];
+uint16_t (*stub_analog_source)(uint8_t pin) = NULL;
+unsigned long stub_analog_reads = 0;
+uint8_t stub_analog_reference = DEFAULT;
+std::string stub_serial;
+std::string stub_serial_input;
+uint8_t stub_eeprom[1024];
+std::vector<std::vector<uint8_t> > stub_wire;
+std::vector<uint8_t> stub_u8g_pages;
+
+void stubReset() {
+    stub_micros = 0;
+    memset(stub_pins, HIGH, sizeof(stub_pins)); // buttons have pull ups
+    memset(stub_analog, 0, sizeof(stub_analog));
+    stub_analog_source = NULL;
+    stub_analog_reads = 0;
+    stub_serial.clear();
+    stub_serial_input.clear();
+    memset(stub_eeprom, 0xFF, sizeof(stub_eeprom));
+    stub_wire.clear();
+    stub_u8g_pages.clear();
+}
+
+// core
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if(pin < STUB_PINS) {
+        stub_pins[pin] = value ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < STUB_PINS ? stub_pins[pin] : LOW;
+}
+
+static uint16_t stubConvert(uint8_t pin) {
+    if(pin < A0) {
+        pin += A0;
+    }
+    stub_analog_reads++;
+    if(stub_analog_source) {
+        return stub_analog_source(pin);
+    }
+    return pin < STUB_PINS ? stub_analog[pin] : 0;
+}
+
+void analogReference(uint8_t mode) {
+    stub_analog_reference = mode;
+}
+
+int analogRead(uint8_t pin) {
+    stub_micros += STUB_ADC_TIME;
+    return stubConvert(pin);
+}
+
+void StubAdcsra::operator=(uint8_t value) volatile {
+    bits = value & ~_BV(ADSC);
+    if(value & _BV(ADSC)) {
+        ADC = stubConvert(ADMUX & 0x07);
+    }
+}
+
+unsigned long millis() {
+    return stub_micros / 1000;
+}
+
+unsigned long micros() {
+    return stub_micros;
+}
+
+void delay(unsigned long ms) {
+    stub_micros += ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+    stub_micros += us;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+long random(long max) {
+    return max > 0 ? rand() % max : 0;
+}
+
+long random(long min, long max) {
+    return min < max ? min + random(max - min) : min;
+}
+
+void noInterrupts() {}
+void interrupts() {}
+void cli() {}
+void sei() {}
+
+// Print, the same digits as the Arduino core
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while(size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+    char buf[8 * sizeof(long) + 1];
+    char *str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if(base < 2) {
+        base = 10;
+    }
+    do {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while(n);
+    return write(str);
+}
+
+size_t Print::print(long n, int base) {
+    if(base == 10 && n < 0) {
+        return print('-') + printNumber(-n, 10);
+    }
+    return printNumber(n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+}
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t c) {
+    stub_serial += (char)c;
+    return 1;
+}
+
+int HardwareSerial::available() {
+    return stub_serial_input.size();
+}
+
+int HardwareSerial::read() {
+    if(stub_serial_input.empty()) {
+        return -1;
+    }
+    int c = (uint8_t)stub_serial_input[0];
+    stub_serial_input.erase(0, 1);
+    return c;
+}
+
+// EEPROM
+
+EEPROMClass EEPROM;
+
+uint8_t EEPROMClass::read(int address) {
+    return stub_eeprom[address % sizeof(stub_eeprom)];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    stub_eeprom[address % sizeof(stub_eeprom)] = value;
+}
+
+// Wire
+
+TwoWire Wire;
+
+void TwoWire::beginTransmission(uint8_t address) {
+    stub_wire.push_back(std::vector<uint8_t>(1, address));
+}
+
+size_t TwoWire::write(uint8_t value) {
+    stub_wire.back().push_back(value);
+    return 1;
+}
+
+uint8_t TwoWire::endTransmission() {
+    return 0;
+}
+
+// u8glib
+
+const uint8_t u8g_font_fixed_v0[] = { 0 };
+const uint8_t u8g_font_6x10[] = { 0 };
+const uint8_t u8g_font_5x8[] = { 0 };
+const uint8_t u8g_font_10x20[] = { 0 };
+const uint8_t u8g_font_fub30[] = { 0 };
+uint8_t u8g_dev_rot180_fn;
+
+U8GLIB::U8GLIB() {
+    pb.p.page_height = 8;
+    pb.p.total_height = 64;
+    pb.p.page = 0;
+    pb.width = 128;
+    pb.buf = buffer;
+    dev.dev_fn = NULL;
+    dev.dev_mem = &pb;
+    dev.com_fn = NULL;
+    u8g.dev = &dev;
+}
+
+void U8GLIB::setRot180() {
+    rot.dev_fn = &u8g_dev_rot180_fn;
+    rot.dev_mem = &dev;
+    rot.com_fn = NULL;
+    u8g.dev = &rot;
+}
+
+static u8g_pb_t *pageBuffer(u8g_t *u8g) {
+    u8g_dev_t *dev = u8g->dev;
+    if(dev->dev_fn == &u8g_dev_rot180_fn) {
+        dev = (u8g_dev_t *)dev->dev_mem;
+    }
+    return (u8g_pb_t *)dev->dev_mem;
+}
+
+uint8_t u8g_page_Next(u8g_page_t *p) {
+    p->page_y0 += p->page_height;
+    if(p->page_y0 >= p->total_height) {
+        return 0;
+    }
+    p->page++;
+    u8g_uint_t y1 = p->page_y1 + p->page_height;
+    p->page_y1 = y1 >= p->total_height ? p->total_height - 1 : y1;
+    return 1;
+}
+
+void u8g_GetPageBox(u8g_t *u8g, u8g_box_t *box) {
+    u8g_pb_t *pb = pageBuffer(u8g);
+    box->x0 = 0;
+    box->x1 = pb->width - 1;
+    box->y0 = pb->p.page_y0;
+    box->y1 = pb->p.page_y1;
+    if(u8g->dev->dev_fn == &u8g_dev_rot180_fn) {
+        box->y0 = pb->p.total_height - 1 - pb->p.page_y1;
+        box->y1 = pb->p.total_height - 1 - pb->p.page_y0;
+    }
+}
+
+void u8g_pb_Clear(u8g_pb_t *pb) {
+    memset(pb->buf, 0, pb->width);
+}
+
+void u8g_FirstPage(u8g_t *u8g) {
+    u8g_pb_t *pb = pageBuffer(u8g);
+    pb->p.page = 0;
+    pb->p.page_y0 = 0;
+    pb->p.page_y1 = pb->p.page_height - 1;
+    u8g_pb_Clear(pb);
+    u8g_GetPageBox(u8g, &u8g->current_page);
+}
+
+uint8_t u8g_NextPage(u8g_t *u8g) {
+    u8g_pb_t *pb = pageBuffer(u8g);
+    stub_u8g_pages.push_back(pb->p.page);
+    u8g_pb_Clear(pb);
+    if(!u8g_page_Next(&pb->p)) {
+        return 0;
+    }
+    u8g_GetPageBox(u8g, &u8g->current_page);
+    return 1;
+}
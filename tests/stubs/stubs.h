@@ -0,0 +1,24 @@
+// Controls of the host stand-ins, see stubs.cpp.
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define STUB_PINS 22
+#define STUB_ADC_TIME 112 // us per analogRead(), 13 adc clocks at prescaler 128
+
+extern unsigned long stub_micros; // advanced by delay() and analogRead()
+extern uint8_t stub_pins[STUB_PINS]; // digitalRead() and digitalWrite()
+extern uint16_t stub_analog[STUB_PINS]; // analogRead() when there is no source
+extern uint16_t (*stub_analog_source)(uint8_t pin); // analogRead() of a test
+extern unsigned long stub_analog_reads;
+extern uint8_t stub_analog_reference; // not reset, adc.cpp keeps track of it
+extern std::string stub_serial; // everything written to Serial
+extern std::string stub_serial_input; // read by Serial.read()
+extern uint8_t stub_eeprom[1024];
+// one entry per I2C transmission, the address first
+extern std::vector<std::vector<uint8_t> > stub_wire;
+// controller page of every page u8glib has sent
+extern std::vector<uint8_t> stub_u8g_pages;
+
+void stubReset();
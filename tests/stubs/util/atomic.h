@@ -0,0 +1,5 @@
+// Host stand-in for <util/atomic.h>, the tests run single threaded.
+#pragma once
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_BLOCK(type) for(int atomic_once = 1; atomic_once; atomic_once = 0)
@@ -0,0 +1,30 @@
+// Checks for the host tests. A failed check prints where it failed and the
+// test keeps going, main() returns testResult().
+#pragma once
+#include <stdio.h>
+#include "stubs.h"
+
+static int test_checks = 0;
+static int test_failures = 0;
+
+#define CHECK(condition) do { \
+        test_checks++; \
+        if(!(condition)) { \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            test_failures++; \
+        } \
+    } while(0)
+
+#define CHECK_EQUAL(expected, actual) do { \
+        long long check_expected = (expected), check_actual = (actual); \
+        test_checks++; \
+        if(check_expected != check_actual) { \
+            printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, check_actual, check_expected); \
+            test_failures++; \
+        } \
+    } while(0)
+
+static int testResult(const char *name) {
+    printf("%s: %d checks, %d failed\n", name, test_checks, test_failures);
+    return test_failures ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+// ADC self test statistics on known read sequences.
+
+#include <Arduino.h>
+#include <sstream>
+#include "settings.h"
+#include "adc.h"
+#include "test.h"
+
+// a pattern per pin, every other read has the same spread so the discarded
+// reads do not change it.
+static const uint16_t *pattern;
+static uint8_t pattern_length;
+static uint16_t reads[STUB_PINS];
+static uint16_t patternSource(uint8_t pin) {
+    return pattern[reads[pin]++ % pattern_length];
+}
+
+// reads of the internal reference, the mean has to come from its lines
+static uint16_t internal_offset;
+static uint16_t referenceSource(uint8_t pin) {
+    return patternSource(pin) + (stub_analog_reference == INTERNAL ? internal_offset : 0);
+}
+
+// sd/10 columns of every reference, prescaler and discard line
+static void selfTest(const uint16_t *values, uint8_t length, std::vector<long> *means, std::vector<long> *sds) {
+    stubReset();
+    memset(reads, 0, sizeof(reads));
+    pattern = values;
+    pattern_length = length;
+    stub_analog_source = referenceSource;
+    adcSelfTest();
+    CHECK_EQUAL(DEFAULT, stub_analog_reference); // ADC_REFERENCE again
+    means->clear();
+    sds->clear();
+    std::istringstream lines(stub_serial);
+    std::string line;
+    std::getline(lines, line); // header
+    uint8_t count = 0;
+    while(std::getline(lines, line)) {
+        std::istringstream fields(line.substr(line.find(' ')));
+        long reference, prescaler, discard, time, mean, sd;
+        fields >> reference >> prescaler >> discard >> time;
+        CHECK_EQUAL(count < 8 ? 5000 : 1100, reference);
+        while(fields >> mean >> sd) {
+            means->push_back(reference == 1100 ? mean - internal_offset : mean);
+            sds->push_back(sd);
+        }
+        count++;
+    }
+    CHECK_EQUAL(16, count);
+}
+
+static void testStats() {
+    std::vector<long> means, sds;
+    internal_offset = 0;
+    const uint16_t constant[] = { 300 };
+    selfTest(constant, 1, &means, &sds);
+    for(size_t i = 0; i < sds.size(); i++) {
+        CHECK_EQUAL(300, means[i]);
+        CHECK_EQUAL(0, sds[i]);
+    }
+#ifdef USE_DIVERSITY
+    CHECK_EQUAL(32, sds.size());
+#else
+    CHECK_EQUAL(16, sds.size());
+#endif
+
+    // a mean of 100.5 and 0.5 steps of noise, the truncated mean made it 10
+    const uint16_t half[] = { 100, 101, 101, 100 };
+    selfTest(half, 4, &means, &sds);
+    for(size_t i = 0; i < sds.size(); i++) {
+        CHECK_EQUAL(100, means[i]);
+        CHECK_EQUAL(5, sds[i]);
+    }
+
+    // 2 steps of noise at full scale, N*squares needs more than 32 bit
+    const uint16_t wide[] = { 1021, 1023, 1023, 1021 };
+    selfTest(wide, 4, &means, &sds);
+    for(size_t i = 0; i < sds.size(); i++) {
+        CHECK_EQUAL(1022, means[i]);
+        CHECK_EQUAL(10, sds[i]);
+    }
+
+    // sd 2.5, 0 0 5 5
+    const uint16_t spread[] = { 500, 500, 505, 505, 505, 505, 500, 500 };
+    selfTest(spread, 8, &means, &sds);
+    for(size_t i = 0; i < sds.size(); i++) {
+        CHECK_EQUAL(502, means[i]);
+        CHECK_EQUAL(25, sds[i]);
+    }
+}
+
+// the lines of the internal reference convert with it
+static void testReference() {
+    std::vector<long> means, sds;
+    const uint16_t constant[] = { 200 };
+    internal_offset = 700;
+    selfTest(constant, 1, &means, &sds);
+    for(size_t i = 0; i < means.size(); i++) {
+        CHECK_EQUAL(200, means[i]);
+        CHECK_EQUAL(0, sds[i]);
+    }
+    internal_offset = 0;
+}
+
+int main() {
+    testStats();
+    testReference();
+    return testResult(TEST_NAME);
+}
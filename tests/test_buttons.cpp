@@ -0,0 +1,240 @@
+// Button debounce and event queue driven by the Timer0 compare A tick.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "buttons.h"
+#include "test.h"
+
+extern "C" void TIMER0_COMPA_vect(void);
+extern "C" void PCINT0_vect(void); // PCINT1 and PCINT2 are aliases
+
+static const uint8_t pins[] = { 0, buttonUp, buttonMode, buttonDown, buttonSave };
+
+static void tick(uint16_t ms) {
+    while(ms--) {
+        stub_micros += 1000;
+        TIMER0_COMPA_vect();
+    }
+}
+
+// the pin changes and raises the pin change interrupt
+static void setPin(uint8_t button, bool pressed) {
+    stub_pins[pins[button]] = pressed ? LOW : HIGH;
+    PCINT0_vect();
+}
+
+// events of the next ms ticks, consumed as they are queued
+static std::vector<uint8_t> events;
+static std::vector<uint16_t> event_ms; // since begin()
+static unsigned long start_ms;
+static void record(uint16_t ms) {
+    while(ms--) {
+        tick(1);
+        for(uint8_t event; (event = buttonEvent()) != BUTTON_NONE; ) {
+            events.push_back(event);
+            event_ms.push_back(millis() - start_ms);
+        }
+    }
+}
+
+static void begin() {
+    stubReset();
+    tick(BUTTON_DEBOUNCE_TIME); // nothing left of the last test
+    buttonsClear();
+    buttonsBegin();
+    events.clear();
+    event_ms.clear();
+    start_ms = millis();
+}
+
+static void testBegin() {
+    PCMSK2 = PCICR = TIMSK0 = 0;
+    begin();
+    CHECK_EQUAL(_BV(buttonUp) | _BV(buttonMode) | _BV(buttonDown) | _BV(buttonSave), PCMSK2);
+    CHECK_EQUAL(_BV(2), PCICR);
+    CHECK(TIMSK0 & _BV(OCIE0A));
+    CHECK_EQUAL(BUTTON_NONE, buttonEvent());
+}
+
+static void testPress() {
+    begin();
+    setPin(BUTTON_UP, true);
+    record(100);
+    setPin(BUTTON_UP, false);
+    record(50);
+    CHECK_EQUAL(2, events.size());
+    CHECK_EQUAL(BUTTON_PRESS | BUTTON_UP, events[0]);
+    CHECK_EQUAL(BUTTON_DEBOUNCE_TIME, event_ms[0]);
+    CHECK_EQUAL(BUTTON_RELEASE | BUTTON_UP, events[1]);
+    CHECK_EQUAL(100 + BUTTON_DEBOUNCE_TIME, event_ms[1]);
+    CHECK(!buttonHeld(BUTTON_UP));
+}
+
+// contacts bouncing for a few ms on press and on release
+static void testBounce() {
+    const uint8_t bounce[] = { 1, 0, 1, 1, 0, 1, 0, 0, 1 };
+    begin();
+    for(uint8_t i = 0; i < sizeof(bounce); i++) {
+        setPin(BUTTON_MODE, bounce[i]);
+        record(1);
+    }
+    record(BUTTON_DEBOUNCE_TIME + 10);
+    CHECK_EQUAL(1, events.size());
+    CHECK_EQUAL(BUTTON_PRESS | BUTTON_MODE, events[0]);
+    // stable for BUTTON_DEBOUNCE_TIME after the last change
+    CHECK_EQUAL(sizeof(bounce) - 1 + BUTTON_DEBOUNCE_TIME, event_ms[0]);
+    CHECK(buttonHeld(BUTTON_MODE));
+
+    events.clear();
+    for(uint8_t i = 0; i < sizeof(bounce); i++) {
+        setPin(BUTTON_MODE, !bounce[i]);
+        record(1);
+    }
+    record(BUTTON_DEBOUNCE_TIME + 10);
+    CHECK_EQUAL(1, events.size());
+    CHECK_EQUAL(BUTTON_RELEASE | BUTTON_MODE, events[0]);
+
+    // a glitch shorter than the debounce is no press
+    events.clear();
+    setPin(BUTTON_DOWN, true);
+    record(3);
+    setPin(BUTTON_DOWN, false);
+    record(BUTTON_DEBOUNCE_TIME * 2);
+    CHECK_EQUAL(0, events.size());
+}
+
+// a button held at power up is no press, its release is
+static void testHeldAtBoot() {
+    stubReset();
+    stub_pins[buttonSave] = LOW;
+    tick(BUTTON_DEBOUNCE_TIME);
+    buttonsClear();
+    buttonsBegin();
+    events.clear();
+    record(100);
+    CHECK_EQUAL(0, events.size());
+    setPin(BUTTON_SAVE, false);
+    record(100);
+    CHECK_EQUAL(1, events.size());
+    CHECK_EQUAL(BUTTON_RELEASE | BUTTON_SAVE, events[0]);
+}
+
+static void testLongPress() {
+    begin();
+    setPin(BUTTON_SAVE, true);
+    record(BUTTON_DEBOUNCE_TIME + BUTTON_LONG_TIME + 100);
+    setPin(BUTTON_SAVE, false);
+    record(100);
+    uint8_t longs = 0;
+    for(size_t i = 0; i < events.size(); i++) {
+        if(events[i] == (BUTTON_LONG | BUTTON_SAVE)) {
+            longs++;
+            // the tick of the press is the first ms held
+            CHECK_EQUAL(BUTTON_DEBOUNCE_TIME + BUTTON_LONG_TIME - 1, event_ms[i]);
+        }
+    }
+    CHECK_EQUAL(1, longs);
+    CHECK_EQUAL(BUTTON_PRESS | BUTTON_SAVE, events.front());
+    CHECK_EQUAL(BUTTON_RELEASE | BUTTON_SAVE, events.back());
+}
+
+// the queue holds BUTTON_QUEUE-1 events, later ones are dropped
+static void testOverflow() {
+    begin();
+    for(uint8_t i = 0; i < 5; i++) {
+        uint8_t button = BUTTON_UP + i % 4;
+        setPin(button, true);
+        tick(BUTTON_DEBOUNCE_TIME + 10);
+        setPin(button, false);
+        tick(BUTTON_DEBOUNCE_TIME + 10);
+    }
+    for(uint8_t i = 0; i < 7; i++) {
+        uint8_t button = BUTTON_UP + i / 2 % 4;
+        CHECK_EQUAL((i % 2 ? BUTTON_RELEASE : BUTTON_PRESS) | button, buttonEvent());
+    }
+    CHECK_EQUAL(BUTTON_NONE, buttonEvent());
+
+    // room again after reading
+    setPin(BUTTON_DOWN, true);
+    tick(BUTTON_DEBOUNCE_TIME);
+    CHECK_EQUAL(BUTTON_PRESS | BUTTON_DOWN, buttonEvent());
+    setPin(BUTTON_DOWN, false);
+    tick(BUTTON_DEBOUNCE_TIME);
+    buttonsClear();
+    CHECK_EQUAL(BUTTON_NONE, buttonEvent());
+}
+
+// repeats after BUTTON_REPEAT_DELAY, a quarter faster every repeat down to
+// BUTTON_REPEAT_MIN
+static void testRepeat() {
+    static_assert(BUTTON_REPEAT_DELAY == 400 && BUTTON_REPEAT_TIME == 150 && BUTTON_REPEAT_MIN == 30, "timings below");
+    const uint16_t apart[] = { 150, 113, 85, 64, 48, 36, 30, 30, 30 };
+    for(uint8_t run = 0; run < 2; run++) { // the next hold starts slow again
+        begin();
+        setPin(BUTTON_DOWN, true);
+        record(1500);
+        setPin(BUTTON_DOWN, false);
+        record(100);
+        std::vector<uint16_t> repeats;
+        for(size_t i = 0; i < events.size(); i++) {
+            if(events[i] == (BUTTON_REPEAT | BUTTON_DOWN)) {
+                repeats.push_back(event_ms[i]);
+            }
+        }
+        CHECK(repeats.size() > sizeof(apart)/sizeof(apart[0]));
+        // the tick of the press is the first ms held
+        CHECK_EQUAL(BUTTON_DEBOUNCE_TIME + BUTTON_REPEAT_DELAY - 1, repeats[0]);
+        for(uint8_t i = 1; i < repeats.size(); i++) {
+            uint16_t expected = i <= sizeof(apart)/sizeof(apart[0]) ? apart[i-1] : BUTTON_REPEAT_MIN;
+            CHECK_EQUAL(expected, repeats[i] - repeats[i-1]);
+        }
+        CHECK_EQUAL(BUTTON_RELEASE | BUTTON_DOWN, events.back());
+    }
+
+    // a slow main loop gets one repeat at a time, none are left after the
+    // release
+    begin();
+    setPin(BUTTON_UP, true);
+    tick(1500);
+    setPin(BUTTON_UP, false);
+    tick(100);
+    CHECK_EQUAL(BUTTON_PRESS | BUTTON_UP, buttonEvent());
+    CHECK_EQUAL(BUTTON_LONG | BUTTON_UP, buttonEvent());
+    CHECK_EQUAL(BUTTON_RELEASE | BUTTON_UP, buttonEvent());
+    CHECK_EQUAL(BUTTON_NONE, buttonEvent());
+
+    begin();
+    setPin(BUTTON_UP, true);
+    tick(BUTTON_DEBOUNCE_TIME);
+    CHECK_EQUAL(BUTTON_PRESS | BUTTON_UP, buttonEvent());
+    tick(900);
+    CHECK_EQUAL(BUTTON_REPEAT | BUTTON_UP, buttonEvent());
+    CHECK_EQUAL(BUTTON_NONE, buttonEvent());
+    setPin(BUTTON_UP, false);
+    tick(100);
+}
+
+// presses only, no waiting with a timeout of 0
+static void testWait() {
+    begin();
+    setPin(BUTTON_UP, true);
+    tick(BUTTON_DEBOUNCE_TIME);
+    setPin(BUTTON_UP, false);
+    tick(BUTTON_DEBOUNCE_TIME);
+    // the release is skipped, the press is returned
+    CHECK_EQUAL(BUTTON_PRESS | BUTTON_UP, buttonWait(0));
+    CHECK_EQUAL(BUTTON_NONE, buttonWait(0));
+    CHECK_EQUAL(BUTTON_NONE, buttonEvent());
+}
+
+int main() {
+    testBegin();
+    testPress();
+    testBounce();
+    testHeldAtBoot();
+    testLongPress();
+    testOverflow();
+    testRepeat();
+    testWait();
+    return testResult(TEST_NAME);
+}
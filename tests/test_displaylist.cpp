@@ -0,0 +1,255 @@
+// Display list of the SSD1306 screens: clipping of the primitives to the
+// 8 row pages and the changed columns that are sent.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "screens.h"
+#include "widgets.h"
+#include "displaylist.h"
+#include <fontALL.h>
+#include "test.h"
+
+extern uint16_t ssd1306_page_renders;
+extern uint16_t ssd1306_page_skips;
+extern uint16_t ssd1306_column_writes;
+
+static uint8_t expected[64][128];
+
+// reference drawing, one pixel at a time
+static void set(int x, int y, uint8_t color) {
+    if(x < 0 || x >= 128 || y < 0 || y >= 64) {
+        return;
+    }
+    switch(color) {
+        case LIST_WHITE: expected[y][x] = 1; break;
+        case LIST_BLACK: expected[y][x] = 0; break;
+        case LIST_INVERT: expected[y][x] ^= 1; break;
+    }
+}
+
+static void box(int x, int y, int w, int h, uint8_t color) {
+    for(int row = y; row < y+h; row++) {
+        for(int col = x; col < x+w; col++) {
+            set(col, row, color);
+        }
+    }
+}
+
+static void text(int x, int y, const char *text, uint8_t color, int size) {
+    for(; *text; text++, x += 6*size) {
+        const unsigned char *glyph = font6x8 + 3 + (*text - ' ')*8;
+        for(int row = 0; row < 8*size; row++) {
+            for(int col = 0; col < 8; col++) {
+                if(glyph[row/size] & (0x80 >> col)) {
+                    box(x + col*size, y + row, size, 1, color);
+                }
+            }
+        }
+    }
+}
+
+// renders all pages and compares them with the reference, returns the
+// number of pixels that differ.
+static int compare() {
+    uint8_t buffer[PAGE_WIDTH];
+    int differ = 0;
+    for(uint8_t page = 0; page < 8; page++) {
+        memset(buffer, 0, sizeof(buffer));
+        listRender(buffer, page);
+        for(int x = 0; x < 128; x++) {
+            for(int bit = 0; bit < 8; bit++) {
+                if(((buffer[x] >> bit) & 1) != expected[page*8 + bit][x]) {
+                    differ++;
+                }
+            }
+        }
+    }
+    return differ;
+}
+
+static void testPageMask() {
+    CHECK_EQUAL(0x01, pageMask(0, 7));
+    CHECK_EQUAL(0x03, pageMask(7, 8));
+    CHECK_EQUAL(0x06, pageMask(8, 23));
+    CHECK_EQUAL(0xFF, pageMask(0, 63));
+    CHECK_EQUAL(0x80, pageMask(56, 63));
+    CHECK_EQUAL(0xC0, pageMask(50, 200)); // clipped to the last row
+}
+
+static void testPageFill() {
+    uint8_t buffer[PAGE_WIDTH];
+    // rows 6 to 9 are split over page 0 and 1
+    memset(buffer, 0, sizeof(buffer));
+    pageFill(buffer, 0, 10, 6, 3, 4, LIST_WHITE);
+    CHECK_EQUAL(0xC0, buffer[10]);
+    CHECK_EQUAL(0xC0, buffer[12]);
+    CHECK_EQUAL(0, buffer[9]);
+    CHECK_EQUAL(0, buffer[13]);
+    memset(buffer, 0, sizeof(buffer));
+    pageFill(buffer, 1, 10, 6, 3, 4, LIST_WHITE);
+    CHECK_EQUAL(0x03, buffer[11]);
+    memset(buffer, 0, sizeof(buffer));
+    pageFill(buffer, 2, 10, 6, 3, 4, LIST_WHITE);
+    CHECK_EQUAL(0, buffer[11]);
+
+    // a page inside the fill, black and invert only touch the rows covered
+    memset(buffer, 0xFF, sizeof(buffer));
+    pageFill(buffer, 3, 0, 20, 1, 30, LIST_BLACK);
+    CHECK_EQUAL(0, buffer[0]);
+    pageFill(buffer, 3, 1, 30, 1, 2, LIST_INVERT);
+    CHECK_EQUAL(0x3F, buffer[1]);
+
+    // columns right of the page are clipped
+    memset(buffer, 0, sizeof(buffer));
+    pageFill(buffer, 0, 126, 0, 10, 8, LIST_WHITE);
+    CHECK_EQUAL(0xFF, buffer[126]);
+    CHECK_EQUAL(0xFF, buffer[127]);
+    CHECK_EQUAL(0, buffer[0]);
+    pageFill(buffer, 0, 130, 0, 10, 8, LIST_WHITE);
+    CHECK_EQUAL(0, buffer[2]);
+
+    // nothing for an empty height
+    pageFill(buffer, 0, 0, 0, 10, 0, LIST_WHITE);
+    CHECK_EQUAL(0, buffer[0]);
+}
+
+static void testPageText() {
+    uint8_t buffer[PAGE_WIDTH];
+    // a glyph 4 rows down is split over two pages
+    const unsigned char *glyph = font6x8 + 3 + ('A' - ' ')*8;
+    for(uint8_t page = 0; page < 2; page++) {
+        memset(buffer, 0, sizeof(buffer));
+        pageText(buffer, page, 20, 4, "A", 1, false, LIST_WHITE, 1);
+        for(uint8_t col = 0; col < 6; col++) {
+            uint8_t bits = 0;
+            for(uint8_t row = 0; row < 8; row++) {
+                int glyph_row = page*8 + row - 4;
+                if(glyph_row >= 0 && glyph_row < 8 && (glyph[glyph_row] & (0x80 >> col))) {
+                    bits |= 1 << row;
+                }
+            }
+            CHECK_EQUAL(bits, buffer[20 + col]);
+        }
+    }
+    // the text stops at the end of the string and the right edge
+    memset(buffer, 0, sizeof(buffer));
+    pageText(buffer, 0, 120, 0, "HHHH", 4, false, LIST_WHITE, 1);
+    CHECK(buffer[120] != 0);
+    CHECK(buffer[126] != 0);
+    memset(buffer, 0, sizeof(buffer));
+    pageText(buffer, 2, 0, 0, "H", 1, false, LIST_WHITE, 1);
+    CHECK_EQUAL(0, buffer[0]);
+}
+
+static const uint8_t arrow[] PROGMEM = { 0xF8, 0x70, 0x20 };
+static const char hello[] PROGMEM = "Hello";
+
+static void testListRender() {
+    static uint8_t graph[4] = { 3, 20, 0, 9 };
+    static char ram[] = "RAM";
+    CHECK(listBegin());
+    memset(expected, 0, sizeof(expected));
+
+    listFrame(0, 0, 128, 64, LIST_WHITE);
+    for(int i = 0; i < 128; i++) {
+        set(i, 0, LIST_WHITE);
+        set(i, 63, LIST_WHITE);
+    }
+    box(0, 0, 1, 64, LIST_WHITE);
+    box(127, 0, 1, 64, LIST_WHITE);
+
+    listBox(2, 5, 50, 11, LIST_WHITE);
+    box(2, 5, 50, 11, LIST_WHITE);
+    listText(4, 6, hello, LIST_BLACK);
+    text(4, 6, "Hello", LIST_BLACK, 1);
+    listTextRam(60, 12, ram, 3, LIST_WHITE, 2);
+    text(60, 12, "RAM", LIST_WHITE, 2);
+    listNumber(3, 30, 5865, LIST_WHITE);
+    text(3, 30, "5865", LIST_WHITE, 1);
+    listNumber(40, 30, 123, LIST_DECIMAL | LIST_INVERT);
+    text(40, 30, "12.3", LIST_INVERT, 1);
+    listGraph(80, 40, 16, 3, 6, graph, 4);
+    for(int i = 0; i < 4; i++) {
+        int value = graph[i] > 16 ? 16 : graph[i];
+        box(80 + i*3, 40 + 16 - value, 3, value, LIST_WHITE);
+    }
+    listBitmap(120, 58, 5, 3, arrow, LIST_WHITE);
+    for(int row = 0; row < 3; row++) {
+        for(int col = 0; col < 5; col++) {
+            if(arrow[row] & (0x80 >> col)) {
+                set(120 + col, 58 + row, LIST_WHITE);
+            }
+        }
+    }
+    uint8_t hidden = listBox(10, 45, 20, 10, LIST_WHITE | LIST_HIDDEN);
+    CHECK_EQUAL(0, compare());
+
+    // shown again
+    CHECK(listStyle(hidden, LIST_WHITE));
+    CHECK(!listStyle(hidden, LIST_WHITE));
+    box(10, 45, 20, 10, LIST_WHITE);
+    uint8_t number = 4;
+    CHECK(listUpdate(number, 5880));
+    CHECK(!listUpdate(number, 5880));
+    box(3, 30, 36, 8, LIST_BLACK);
+    text(3, 30, "5880", LIST_WHITE, 1);
+    CHECK_EQUAL(0, compare());
+
+    // full list
+    while(listBox(0, 0, 1, 1, LIST_BLACK) != LIST_FULL);
+    CHECK_EQUAL(LIST_FULL, listText(0, 0, hello, LIST_WHITE));
+    listClear();
+    memset(expected, 0, sizeof(expected));
+    CHECK_EQUAL(0, compare());
+}
+
+static screens drawScreen;
+
+static void update(uint8_t rssi) {
+    ssd1306_page_renders = 0;
+    ssd1306_column_writes = 0;
+    drawScreen.updateSeekMode(STATE_MANUAL, 0, 0, rssi, 5865, 50, false);
+}
+
+static void testColumns() {
+    drawScreen.begin("TEST");
+    drawScreen.seekMode(STATE_MANUAL);
+    update(50);
+    update(50);
+    CHECK_EQUAL(0, ssd1306_page_renders);
+    CHECK_EQUAL(0, ssd1306_column_writes);
+
+    // the rssi bar grows from 62 to 64 pixels, columns 63 and 64 of page 4
+    update(52);
+    CHECK_EQUAL(1, ssd1306_page_renders);
+    CHECK_EQUAL(2, ssd1306_column_writes);
+    update(50);
+    CHECK_EQUAL(1, ssd1306_page_renders);
+    CHECK_EQUAL(2, ssd1306_column_writes);
+
+    // columns are kept per page, both pages of the first area are sent
+    widgetInvalidate(10, 6, 5, 4);
+    widgetInvalidate(100, 9, 2, 1);
+    update(50);
+    CHECK_EQUAL(2, ssd1306_page_renders);
+    CHECK_EQUAL(5 + (101 - 10 + 1), ssd1306_column_writes);
+    update(50);
+    CHECK_EQUAL(0, ssd1306_column_writes);
+
+    // clipped to the display
+    widgetInvalidate(120, 60, 20, 10);
+    widgetInvalidate(130, 0, 5, 5);
+    update(50);
+    CHECK_EQUAL(1, ssd1306_page_renders);
+    CHECK_EQUAL(8, ssd1306_column_writes);
+}
+
+int main() {
+    stubReset();
+    testPageMask();
+    testPageFill();
+    testPageText();
+    testListRender();
+    testColumns();
+    return testResult("displaylist");
+}
@@ -0,0 +1,53 @@
+// The integer seek threshold and diversity cutover against the single
+// precision expressions they replaced, built for every DIVERSITY_CUTOVER.
+
+#include <Arduino.h>
+#include <math.h>
+#include "settings.h"
+#include "rssi.h"
+#include "test.h"
+
+static uint8_t floatSeekThreshold(uint16_t best) {
+    return (int)((float)best * (float)(RSSI_SEEK_TRESHOLD/100.0));
+}
+
+static bool floatCutover(int a, int b) {
+    float ratio = ((float)a - (float)b) / (float)b;
+    return (int)fabs(ratio * 100.0) >= DIVERSITY_CUTOVER;
+}
+
+static void testSeekThreshold() {
+    uint16_t mismatches = 0;
+    for(uint16_t best = 0; best <= 4095; best++) {
+        mismatches += floatSeekThreshold(best) != seekThreshold(best);
+    }
+    CHECK_EQUAL(0, mismatches);
+}
+
+// B of 0 divided by zero in the float version, it is left out. Exactly on
+// the cutover the float ratio can come out as 0.99999998 of it and truncate
+// below, the integer version switches there as the setting says.
+static void testCutover() {
+    unsigned long mismatches = 0;
+    for(int b = -300; b <= 4200; b++) {
+        if(!b) {
+            continue;
+        }
+        for(int a = -300; a <= 4200; a++) {
+            bool edge = labs((long)a - b) * 100 == (long)DIVERSITY_CUTOVER * abs(b);
+            if(edge) {
+                CHECK(rssiCutover(a, b));
+            }
+            else {
+                mismatches += floatCutover(a, b) != rssiCutover(a, b);
+            }
+        }
+    }
+    CHECK_EQUAL(0, mismatches);
+}
+
+int main() {
+    testSeekThreshold();
+    testCutover();
+    return testResult(TEST_NAME);
+}
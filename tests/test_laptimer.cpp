@@ -0,0 +1,171 @@
+// Lap timer gate detection against replayed rssi traces of receiver A.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "adc.h"
+#include "laptimer.h"
+#include "test.h"
+
+// main project
+uint16_t rssi_min_a = 100;
+uint16_t rssi_max_a = 500; // enter at 420, exit at 340
+void setChannelModule(uint8_t channel, uint8_t select_pin) {}
+extern "C" void TIMER0_COMPB_vect(void); // the sample tick
+
+// passes through the gate, a parabola of rssi around the peak time
+#define PASSES 8
+static unsigned long pass_ms[PASSES];
+static unsigned long pass_half_ms; // to the edge of the parabola
+
+static uint16_t receiverA(uint8_t pin) {
+    if(pin != rssiPinA) {
+        return rssi_min_a;
+    }
+    long level = rssi_min_a;
+    for(uint8_t i = 0; i < PASSES && pass_ms[i]; i++) {
+        long t = (long)(stub_micros / 100) - (long)pass_ms[i] * 10; // 0.1 ms
+        long half = pass_half_ms * 10;
+        if(t > -half && t < half) {
+            level += (rssi_max_a - rssi_min_a) * (half*half - t*t) / (half*half);
+        }
+    }
+    return level;
+}
+
+static void replay(unsigned long half_ms, unsigned long p0 = 0, unsigned long p1 = 0, unsigned long p2 = 0, unsigned long p3 = 0) {
+    stubReset();
+    memset(pass_ms, 0, sizeof(pass_ms));
+    pass_ms[0] = p0;
+    pass_ms[1] = p1;
+    pass_ms[2] = p2;
+    pass_ms[3] = p3;
+    pass_half_ms = half_ms;
+    stub_analog_source = receiverA;
+    lapTimerStop();
+    lapTimerStart();
+}
+
+// the main loop draws the screen for 45 ms between the lap reports and
+// reads both receivers like readRSSI(), the tick keeps sampling.
+static uint8_t reported;
+static void loopUntil(unsigned long ms) {
+    while(millis() < ms) {
+        for(uint8_t i = 0; i < 45; i++) {
+            stub_micros += 1024;
+            TIMER0_COMPB_vect();
+        }
+        adcRead(rssiPinA);
+        adcRead(rssiPinB);
+        if(lapTimerRun(LAP_SAMPLE_TIME)) {
+            reported++;
+        }
+    }
+}
+
+static void testLaps() {
+    replay(80, 1000, 4500, 8000);
+    reported = 0;
+    CHECK(TIMSK0 & _BV(OCIE0B));
+    loopUntil(10000);
+    CHECK_EQUAL(2, lap_count[0]);
+    CHECK_EQUAL(2, reported);
+    CHECK(abs((long)lap_times[0][0] - 3500) <= 3); // filter lag and sample grid
+    CHECK(abs((long)lap_times[0][1] - 3500) <= 3);
+    CHECK(stub_serial.find("START\r\nLAP 1 ") == 0);
+    CHECK(stub_serial.find("\r\nLAP 2 ") != std::string::npos);
+    // ~2 ms per sample
+    CHECK(lap_samples >= 20 && lap_samples <= 24);
+}
+
+// above the enter threshold for less than a screen update, these fell
+// between the samples of the main loop
+static void testShortPasses() {
+    replay(40, 1013, 4531, 8049, 11570);
+    reported = 0;
+    loopUntil(13000);
+    CHECK_EQUAL(3, lap_count[0]);
+    CHECK_EQUAL(3, reported);
+    CHECK(abs((long)lap_times[0][0] - 3518) <= 3);
+    CHECK(abs((long)lap_times[0][1] - 3518) <= 3);
+    CHECK(abs((long)lap_times[0][2] - 3521) <= 3);
+}
+
+// a dip below the exit threshold in the middle of a pass
+static void testSamePass() {
+    replay(60, 1000, 1110, 5000);
+    reported = 0;
+    loopUntil(6000);
+    CHECK_EQUAL(1, lap_count[0]);
+    CHECK(stub_serial.find("START\r\nLAP 1 ") == 0);
+    CHECK(abs((long)lap_times[0][0] - 4000) <= 120);
+}
+
+// the tick does not touch the ADC while the main loop converts
+static unsigned long nested_reads;
+static uint16_t tickDuringRead(uint8_t pin) {
+    if(pin == rssiPinB) {
+        unsigned long reads = stub_analog_reads;
+        for(uint8_t i = 0; i < LAP_SAMPLE_TICKS * 2; i++) {
+            TIMER0_COMPB_vect();
+        }
+        nested_reads += stub_analog_reads - reads;
+    }
+    return rssi_min_a;
+}
+
+static void testBusy() {
+    replay(80);
+    lapTimerRun(LAP_SAMPLE_TIME);
+    stub_analog_source = tickDuringRead;
+    nested_reads = 0;
+    adcRead(rssiPinB);
+    CHECK_EQUAL(0, nested_reads);
+    CHECK_EQUAL(0, lapTimerRun(LAP_SAMPLE_TIME));
+    CHECK_EQUAL(0, lap_samples);
+    // the next tick starts a conversion, the one after collects it
+    unsigned long reads = stub_analog_reads;
+    TIMER0_COMPB_vect();
+    CHECK(stub_analog_reads > reads);
+    CHECK_EQUAL(0, lapTimerRun(LAP_SAMPLE_TIME));
+    CHECK_EQUAL(0, lap_samples);
+    TIMER0_COMPB_vect();
+    lapTimerRun(LAP_SAMPLE_TIME);
+    CHECK_EQUAL(1, lap_samples);
+
+    lapTimerStop();
+    CHECK(!(TIMSK0 & _BV(OCIE0B)));
+    CHECK_EQUAL(0, lapTimerRun(LAP_SAMPLE_TIME));
+}
+
+// the main loop finishes a conversion of the tick before its own, the
+// tick still gets its value and never waits for the ADC
+static uint16_t handover_level;
+static uint16_t handoverSource(uint8_t pin) {
+    return pin == rssiPinA ? handover_level : rssi_min_a;
+}
+
+static void testHandover() {
+    replay(80);
+    stub_analog_source = handoverSource;
+    handover_level = rssi_max_a;
+    unsigned long start = stub_micros;
+    TIMER0_COMPB_vect(); // starts
+    CHECK_EQUAL(start, stub_micros);
+    CHECK(!adcStart(rssiPinA)); // not collected yet
+    handover_level = rssi_min_a;
+    CHECK_EQUAL(rssi_min_a, adcRead(rssiPinB));
+    uint16_t value = 0;
+    CHECK(adcCollect(&value));
+    CHECK_EQUAL(rssi_max_a, value);
+    CHECK(!adcCollect(&value));
+    lapTimerStop();
+}
+
+int main() {
+    testLaps();
+    testShortPasses();
+    testSamePass();
+    testBusy();
+    testHandover();
+    return testResult(TEST_NAME);
+}
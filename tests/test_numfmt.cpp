@@ -0,0 +1,59 @@
+// numFormat against the digits Print gives for every 16 bit number, the
+// stub Print turns numbers into text the way the Arduino core does.
+
+#include <Arduino.h>
+#include <string>
+#include "numfmt.h"
+#include "test.h"
+
+class TextPrint : public Print
+{
+    public:
+        std::string text;
+        size_t write(uint8_t c) { text += (char)c; return 1; }
+};
+
+static std::string format(uint16_t number, uint8_t style, uint8_t width = 0) {
+    char text[NUM_SIZE];
+    uint8_t length = numFormat(text, number, style, width);
+    CHECK_EQUAL(strlen(text), length);
+    return text;
+}
+
+// right aligned the way the screens lined up Print output
+static std::string pad(const std::string &text, uint8_t width, char with) {
+    return text.size() < width ? std::string(width - text.size(), with) + text : text;
+}
+
+static void testPrint() {
+    unsigned long mismatches = 0;
+    for(uint32_t number = 0; number <= 0xFFFF; number++) {
+        TextPrint decimal, hex, tenths;
+        decimal.print((unsigned int)number);
+        hex.print((unsigned int)number, HEX);
+        tenths.print((unsigned int)number / 10);
+        tenths.print('.');
+        tenths.print((unsigned int)number % 10);
+
+        mismatches += format(number, 0) != decimal.text;
+        mismatches += format(number, NUM_HEX) != hex.text;
+        mismatches += format(number, NUM_DECIMAL) != tenths.text;
+        mismatches += format(number, 0, 5) != pad(decimal.text, 5, ' ');
+        mismatches += format(number, NUM_HEX | NUM_ZEROS, 4) != pad(hex.text, 4, '0');
+        mismatches += format(number, NUM_DECIMAL, 7) != pad(tenths.text, 7, ' ');
+    }
+    CHECK_EQUAL(0, mismatches);
+}
+
+// wider than NUM_SIZE-1 is clipped, narrower than the number is ignored
+static void testWidth() {
+    CHECK(format(12345, 0, 3) == "12345");
+    CHECK(format(7, NUM_ZEROS, 20) == "0000007");
+    CHECK(format(0, NUM_DECIMAL) == "0.0");
+}
+
+int main() {
+    testPrint();
+    testWidth();
+    return testResult(TEST_NAME);
+}
@@ -0,0 +1,67 @@
+// Peak interpolation of the time sliced lap timer on synthetic gate passes,
+// every pilot is only sampled once per round.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "laptimer.h"
+#include "test.h"
+
+// main project
+uint16_t rssi_min_a = 100;
+uint16_t rssi_max_a = 500;
+static uint8_t tuned_a;
+void setChannelModule(uint8_t channel, uint8_t select_pin) {
+    if(select_pin == slaveSelectPin) {
+        tuned_a = channel;
+    }
+}
+
+// passes of the first pilot, a parabola of rssi around the peak time
+#define PASSES 12
+#define PASS_HALF_MS 200
+static unsigned long pass_ms[PASSES];
+
+static uint16_t receiverA(uint8_t pin) {
+    if(pin != rssiPinA || tuned_a != 32) { // R1, the first pilot channel
+        return rssi_min_a;
+    }
+    long level = rssi_min_a;
+    for(uint8_t i = 0; i < PASSES; i++) {
+        long t = (long)(stub_micros / 100) - (long)pass_ms[i] * 10; // 0.1 ms
+        long half = PASS_HALF_MS * 10L;
+        if(t > -half && t < half) {
+            level += (rssi_max_a - rssi_min_a) * (half*half - t*t) / (half*half);
+        }
+    }
+    return level;
+}
+
+// laps of 3.5 s, every pass 7 ms later on the round than the one before
+static void testLapTimes() {
+    stubReset();
+    stub_analog_source = receiverA;
+    for(uint8_t i = 0; i < PASSES; i++) {
+        pass_ms[i] = 1000 + i * 3507UL;
+    }
+    lapTimerStart();
+    while(millis() < pass_ms[PASSES-1] + 1000) {
+        lapTimerRun(LAP_SAMPLE_TIME);
+    }
+    CHECK_EQUAL(PASSES-1, lap_count[0]);
+    CHECK_EQUAL(0, lap_count[1]);
+    long worst = 0;
+    for(uint8_t i = 0; i < PASSES-1; i++) {
+        worst = max(worst, abs((long)lap_times[0][i] - 3507));
+    }
+    // the strongest sample alone is up to half a round off, a round is
+    // LAP_PILOTS slices of MIN_TUNE_TIME and LAP_SLICE_READS reads.
+    long round = LAP_PILOTS * (MIN_TUNE_TIME + LAP_SLICE_READS * STUB_ADC_TIME / 1000);
+    CHECK(worst <= 4);
+    CHECK(worst < round / 8);
+    lapTimerStop();
+}
+
+int main() {
+    testLapTimes();
+    return testResult(TEST_NAME);
+}
@@ -0,0 +1,480 @@
+// Rssi math of readRSSI(), seek and the band scan.
+
+#include <Arduino.h>
+#include <algorithm>
+#include <math.h>
+#include "settings.h"
+#include "rssi.h"
+#include "test.h"
+
+static void testAverage() {
+    static_assert(RSSI_EXTRA_BITS == 2 && RSSI_FINE == 10, "12 bit averages in tenths of a percent");
+    CHECK_EQUAL(0, rssiAverage(0, 1));
+    CHECK_EQUAL(4092, rssiAverage(1023, 1));
+    CHECK_EQUAL(4092, rssiAverage(64 * 1023, 64)); // the largest sum
+    CHECK_EQUAL(801, rssiAverage(200 + 200 + 200 + 201, 4));
+    CHECK_EQUAL(802, rssiAverage(200 * 25 + 201 * 25, 50));
+    for(uint8_t n = 1; n <= 64; n++) {
+        for(uint32_t sum = 0; sum <= 1023UL * n; sum += 7) {
+            CHECK_EQUAL(sum * 4 / n, rssiAverage(sum, n));
+        }
+    }
+}
+
+// the extra bits are only there if the read noise dithers the level over
+// the adc steps
+static double decimated(double level, double noise) {
+    double total = 0;
+    for(uint16_t run = 0; run < 200; run++) {
+        uint16_t sum = 0;
+        for(uint8_t i = 0; i < 64; i++) {
+            double read = level + noise * ((rand() + 0.5) / RAND_MAX * 2 - 1);
+            sum += constrain(lround(read), 0, 1023);
+        }
+        total += rssiAverage(sum, 64);
+    }
+    return total / 200 / (1 << RSSI_EXTRA_BITS);
+}
+
+static void testDecimation() {
+    srand(4);
+    double last = 0;
+    for(double level = 200; level <= 201; level += 0.125) {
+        double value = decimated(level, 1.0);
+        CHECK(fabs(value - level) < 0.15);
+        CHECK(value > last);
+        last = value;
+    }
+    // no noise, every read is the same step
+    CHECK(fabs(decimated(200.375, 0) - 200) < 1e-9);
+}
+
+static void testScale() {
+    CHECK_EQUAL(RSSI_FINE, rssiScale(90 << RSSI_EXTRA_BITS, 90, 220));
+    CHECK_EQUAL(100 * RSSI_FINE, rssiScale(220 << RSSI_EXTRA_BITS, 90, 220));
+    CHECK_EQUAL(505, rssiScale(155 << RSSI_EXTRA_BITS, 90, 220));
+    // every quarter step of the calibrated range is its own value
+    for(int average = 90 << RSSI_EXTRA_BITS; average < 220 << RSSI_EXTRA_BITS; average++) {
+        CHECK(rssiScale(average + 1, 90, 220) > rssiScale(average, 90, 220));
+    }
+    // outside the calibration the callers clip
+    CHECK(rssiScale(0, 90, 220) < RSSI_FINE);
+    CHECK(rssiScale(4092, 90, 220) > 100 * RSSI_FINE);
+}
+
+static void testCutover() {
+    static_assert(DIVERSITY_CUTOVER == 2, "2 percent of B");
+    CHECK(rssiCutover(510, 500));
+    CHECK(!rssiCutover(509, 500));
+    CHECK(rssiCutover(490, 500));
+    CHECK(!rssiCutover(491, 500));
+    CHECK(!rssiCutover(500, 500));
+    CHECK(rssiCutover(1, 0));
+    CHECK(rssiCutover(0, 0)); // equal, neither receiver is stronger
+    // below the calibration B is negative
+    CHECK(rssiCutover(-49, -50));
+    CHECK(!rssiCutover(-50, -50));
+    CHECK(!rssiCutover(4100, 4020));
+    CHECK(rssiCutover(4101, 4020));
+    // symmetric in the difference
+    for(int b = -300; b <= 1100; b += 3) {
+        for(int d = 0; d <= 40; d++) {
+            CHECK_EQUAL(rssiCutover(b + d, b), rssiCutover(b - d, b));
+        }
+    }
+}
+
+static void testSeekThreshold() {
+    CHECK_EQUAL(0, seekThreshold(0));
+    CHECK_EQUAL(0, seekThreshold(1));
+    CHECK_EQUAL(4, seekThreshold(5));
+    CHECK_EQUAL(79, seekThreshold(99));
+    CHECK_EQUAL(80, seekThreshold(100));
+    for(uint16_t best = 0; best <= 100; best++) {
+        CHECK_EQUAL(best * RSSI_SEEK_TRESHOLD / 100, seekThreshold(best));
+    }
+}
+
+// the candidates of a sweep are the strongest positions, the first of
+// equal readings stays in front.
+static void testSeekRank() {
+    srand(1);
+    for(uint16_t run = 0; run < 200; run++) {
+        uint8_t readings[CHANNEL_MAX+1];
+        uint8_t positions[SEEK_CANDIDATES];
+        uint8_t values[SEEK_CANDIDATES];
+        uint8_t count = 0;
+        for(uint8_t position = CHANNEL_MIN; position <= CHANNEL_MAX; position++) {
+            readings[position] = run < 100 ? 1 + rand() % 100 : 1 + rand() % 4; // ties
+            count = seekRank(positions, values, count, position, readings[position]);
+        }
+        CHECK_EQUAL(SEEK_CANDIDATES, count);
+
+        uint8_t order[CHANNEL_MAX+1];
+        for(uint8_t i = 0; i <= CHANNEL_MAX; i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order, order + CHANNEL_MAX+1, [&](uint8_t a, uint8_t b) { return readings[a] > readings[b]; });
+        for(uint8_t i = 0; i < SEEK_CANDIDATES; i++) {
+            CHECK_EQUAL(order[i], positions[i]);
+            CHECK_EQUAL(readings[order[i]], values[i]);
+        }
+    }
+
+    // fewer readings than candidates
+    uint8_t positions[SEEK_CANDIDATES];
+    uint8_t values[SEEK_CANDIDATES];
+    uint8_t count = seekRank(positions, values, 0, 7, 20);
+    count = seekRank(positions, values, count, 8, 60);
+    CHECK_EQUAL(2, count);
+    CHECK_EQUAL(8, positions[0]);
+    CHECK_EQUAL(7, positions[1]);
+}
+
+// every window of 5 values of 0..4 (all orders and duplicates) and
+// every order of 5 distinct values
+static void testFilterNetwork() {
+    static_assert(RSSI_FILTER_WINDOW == 5, "the sorting network takes 5 reads");
+    for(uint16_t code = 0; code < 5*5*5*5*5; code++) {
+        uint16_t window[5], sorted[5];
+        for(uint16_t i = 0, c = code; i < 5; i++, c /= 5) {
+            window[i] = sorted[i] = (c % 5) * 300;
+        }
+        std::sort(sorted, sorted + 5);
+        uint16_t copy[5];
+        memcpy(copy, window, sizeof(copy));
+        CHECK_EQUAL(sorted[2], rssiFilter(copy, RSSI_FILTER_MEDIAN));
+        CHECK(!memcmp(copy, sorted, sizeof(copy)));
+        CHECK_EQUAL((sorted[1] + sorted[2] + sorted[3]) / 3, rssiFilter(window, RSSI_FILTER_TRIMMED));
+    }
+    uint16_t order[5] = { 10, 20, 30, 1000, 1023 };
+    do {
+        uint16_t window[5];
+        memcpy(window, order, sizeof(window));
+        CHECK_EQUAL(30, rssiFilter(window, RSSI_FILTER_MEDIAN));
+        memcpy(window, order, sizeof(window));
+        CHECK_EQUAL(350, rssiFilter(window, RSSI_FILTER_TRIMMED));
+    } while(std::next_permutation(order, order + 5));
+}
+
+// a steady signal with one multipath spike or dropout in every window
+static void testFilterSpikes() {
+    srand(3);
+    for(uint8_t filter = RSSI_FILTER_MEDIAN; filter <= RSSI_FILTER_TRIMMED; filter++) {
+        uint32_t sum = 0, mean_sum = 0;
+        const uint8_t windows = 10;
+        for(uint8_t w = 0; w < windows; w++) {
+            uint16_t window[RSSI_FILTER_WINDOW];
+            for(uint8_t i = 0; i < RSSI_FILTER_WINDOW; i++) {
+                window[i] = 200 + rand() % 3;
+            }
+            window[rand() % RSSI_FILTER_WINDOW] = w % 2 ? 1023 : 0;
+            for(uint8_t i = 0; i < RSSI_FILTER_WINDOW; i++) {
+                mean_sum += window[i];
+            }
+            uint16_t value = rssiFilter(window, filter);
+            CHECK(value >= 200 && value <= 202);
+            sum += value;
+        }
+        CHECK(abs((int)(sum / windows) - 201) <= 1);
+        // the plain mean is dragged by the spikes
+        CHECK(abs((int)(mean_sum / (windows * RSSI_FILTER_WINDOW)) - 201) > 20);
+    }
+}
+
+// a coarse scan pass of 8 reads took 10 and used all of them, not 5 of 8
+static void testFilterReads() {
+    static_assert(RSSI_FILTER_WINDOW == 5, "windows of 5 below");
+    CHECK_EQUAL(10, rssiFilterReads(SCAN_COARSE_READS, RSSI_FILTER_TRIMMED));
+    CHECK_EQUAL(65, rssiFilterReads(SCAN_FINE_READS, RSSI_FILTER_MEDIAN));
+    CHECK_EQUAL(RSSI_READS, rssiFilterReads(RSSI_READS, RSSI_FILTER_MEDIAN));
+    CHECK_EQUAL(5, rssiFilterReads(1, RSSI_FILTER_MEDIAN));
+    CHECK_EQUAL(SCAN_COARSE_READS, rssiFilterReads(SCAN_COARSE_READS, RSSI_FILTER_MEAN));
+    for(uint8_t reads = 1; reads <= 64; reads++) {
+        uint8_t rounded = rssiFilterReads(reads, RSSI_FILTER_TRIMMED);
+        CHECK(rounded % RSSI_FILTER_WINDOW == 0 && rounded >= reads && rounded < reads + RSSI_FILTER_WINDOW);
+        // the windows of the most reads still fit the 16 bit sum
+        CHECK(rounded / RSSI_FILTER_WINDOW * 1023UL < 0x10000);
+    }
+}
+
+static double gaussian(double sd) {
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sd * sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+// reads of a readRSSI() with adaptive reads, the average is returned
+static uint8_t settleReads(double level, double sd, double *average) {
+    int16_t first = 0, sum = 0;
+    uint32_t squares = 0;
+    uint32_t total = 0;
+    uint8_t reads = 0;
+    while(reads < RSSI_READS) {
+        int16_t read = constrain(lround(level + gaussian(sd)), 0, 1023);
+        reads++;
+        total += read;
+        if(reads == 1) {
+            first = read;
+        }
+        rssiVariance(read - first, &sum, &squares);
+        if(reads >= RSSI_MIN_READS && rssiSettled(reads, sum, squares)) {
+            break;
+        }
+    }
+    *average = (double)total / reads;
+    return reads;
+}
+
+static void testSettled() {
+    srand(2);
+    // the sums against the standard error of the average in floating point
+    const double noise[] = { 0, 0.5, 2, 5, 20, 200 };
+    for(uint8_t model = 0; model < sizeof(noise)/sizeof(noise[0]); model++) {
+        for(uint16_t run = 0; run < 200; run++) {
+            int16_t sum = 0;
+            uint32_t squares = 0;
+            double fsum = 0, fsquares = 0;
+            int16_t first = 300 + gaussian(noise[model]);
+            for(uint8_t n = 1; n <= 64; n++) {
+                int16_t deviation = constrain(lround(300 + gaussian(noise[model])), 0, 1023) - first;
+                rssiVariance(deviation, &sum, &squares);
+                deviation = constrain(deviation, -255, 255);
+                fsum += deviation;
+                fsquares += (double)deviation * deviation;
+                double variance = fsquares / n - (fsum / n) * (fsum / n);
+                double error = sqrt(variance / n);
+                if(fabs(error - RSSI_TARGET_ERROR) > 1e-9) {
+                    CHECK_EQUAL(error < RSSI_TARGET_ERROR, rssiSettled(n, sum, squares));
+                }
+            }
+        }
+    }
+    // a glitch is clipped to 255 steps
+    int16_t sum = 0;
+    uint32_t squares = 0;
+    rssiVariance(1000, &sum, &squares);
+    rssiVariance(-1000, &sum, &squares);
+    CHECK_EQUAL(0, sum);
+    CHECK_EQUAL(2 * 255 * 255, squares);
+
+    // reads and accuracy per noise model
+    double average;
+    CHECK_EQUAL(RSSI_MIN_READS, settleReads(300, 0, &average));
+    CHECK_EQUAL(RSSI_READS, settleReads(300, 50, &average));
+    uint32_t reads = 0;
+    double worst = 0;
+    for(uint16_t run = 0; run < 500; run++) {
+        reads += settleReads(300, 3, &average);
+        worst = max(worst, fabs(average - 300));
+    }
+    // about 9 reads for a variance of 9 at an error of 1
+    CHECK(reads / 500 >= 9 && reads / 500 <= 16);
+    CHECK(worst < 4 * RSSI_TARGET_ERROR);
+}
+
+// one coarse and one fine pass over a band, returns the reads taken
+static uint16_t scanBand(const uint8_t *band, std::vector<uint8_t> *fine) {
+    uint16_t reads = 0;
+    uint8_t channel = CHANNEL_MIN;
+    scan_fine = false;
+    fine->clear();
+    for(uint8_t coarse = CHANNEL_MIN; coarse <= CHANNEL_MAX; coarse++) {
+        CHECK_EQUAL(coarse, channel);
+        reads += SCAN_COARSE_READS;
+        channel = scanNext(channel, band[channel]);
+    }
+    while(scan_fine) {
+        fine->push_back(channel);
+        reads += SCAN_FINE_READS;
+        channel = scanNext(channel, band[channel]);
+    }
+    CHECK_EQUAL(CHANNEL_MIN, channel);
+    return reads;
+}
+
+static void testTwoPassScan() {
+    uint8_t band[CHANNEL_MAX+1];
+    std::vector<uint8_t> fine;
+    for(uint8_t i = 0; i <= CHANNEL_MAX; i++) {
+        band[i] = 3 + i % 4; // noise floor 3..6
+    }
+    // floor 3 + SCAN_NOISE_MARGIN is not above the floor
+    band[3] = 3 + SCAN_NOISE_MARGIN;
+    band[4] = 4 + SCAN_NOISE_MARGIN;
+    band[10] = 80;
+    band[11] = 35;
+    band[CHANNEL_MAX] = 90;
+    uint16_t reads = scanBand(band, &fine);
+    CHECK_EQUAL(3 + SCAN_NOISE_MARGIN, scan_floor);
+    CHECK_EQUAL(4, fine.size());
+    CHECK_EQUAL(4, fine[0]);
+    CHECK_EQUAL(10, fine[1]);
+    CHECK_EQUAL(11, fine[2]);
+    CHECK_EQUAL(CHANNEL_MAX, fine[3]);
+    // under a third of RSSI_READS on every channel
+    CHECK(reads < (CHANNEL_MAX+1) * RSSI_READS / 3);
+
+    // the next sweep starts coarse again
+    band[11] = 4;
+    scanBand(band, &fine);
+    CHECK_EQUAL(3, fine.size());
+
+    // a quiet band has no fine pass
+    memset(band, 5, sizeof(band));
+    reads = scanBand(band, &fine);
+    CHECK_EQUAL(0, fine.size());
+    CHECK_EQUAL((CHANNEL_MAX+1) * SCAN_COARSE_READS, reads);
+}
+
+// the time of a seek on the receiver, a step tunes and waits MIN_TUNE_TIME
+// before RSSI_READS reads of both receivers, checking the same channel
+// again only reads. The sweep settles SEEK_SWEEP_TUNE_TIME and reads
+// receiver A. Drawing is left out.
+#define SEEK_READ_US (RSSI_READS * 2 * STUB_ADC_TIME)
+#define SEEK_TUNE_US (MIN_TUNE_TIME * 1000UL)
+#define SEEK_SWEEP_US (SEEK_SWEEP_TUNE_TIME * 1000UL + RSSI_READS * STUB_ADC_TIME)
+
+static const uint8_t *seek_band;
+static unsigned long seek_us;
+
+// a reading of the scripted band with a little noise
+static uint8_t seekReading(uint8_t position) {
+    int rssi = seek_band[position] + (int)round(gaussian(2));
+    return constrain(rssi, 1, 100);
+}
+
+static uint8_t sweepRead(uint8_t position) {
+    seek_us += SEEK_SWEEP_US;
+    return seekReading(position);
+}
+
+// a seek from start the way the main loop runs it, returns the ms to the
+// lock and the channel it locked on.
+static unsigned long seekTime(const uint8_t *band, uint8_t start, bool guided, uint8_t *locked) {
+    seek_band = band;
+    seek_us = 0;
+    // entering STATE_SEEK
+    rssi_seek_threshold = RSSI_SEEK_TRESHOLD;
+    rssi_best = 0;
+    force_seek = 1;
+    seek_candidate_count = 0;
+    uint8_t channel = start;
+    bool tuned = true;
+    for(uint16_t step = 0; step < 1000; step++) {
+        seek_us += tuned ? SEEK_TUNE_US + SEEK_READ_US : SEEK_READ_US;
+        uint8_t rssi = seekReading(channel);
+        rssi_best = rssi > rssi_best ? rssi : rssi_best;
+        uint8_t next = guided ? seekGuided(channel, rssi) : seekLinear(channel, rssi);
+        if(next == SEEK_SWEEP) {
+            next = seekSweep(sweepRead);
+        }
+        if(next == SEEK_LOCK) {
+            *locked = channel;
+            return seek_us / 1000;
+        }
+        tuned = next != channel;
+        channel = next;
+    }
+    *locked = 255;
+    return seek_us / 1000;
+}
+
+// mean time to lock over every pilot position of a few bands, both
+// strategies. The guided seek pays a sweep but does not need a second
+// pass over the band when the pilot is weaker than RSSI_SEEK_TRESHOLD.
+static void testSeekTime() {
+    static const char *names[] = { "strong pilot", "weak pilot", "bleeding", "two pilots" };
+    unsigned long mean[4][2];
+    srand(3);
+    seek_direction = 1;
+    for(uint8_t environment = 0; environment < 4; environment++) {
+        unsigned long sum[2] = { 0, 0 };
+        for(uint8_t pilot = CHANNEL_MIN; pilot <= CHANNEL_MAX; pilot++) {
+            uint8_t band[CHANNEL_MAX+1];
+            for(uint8_t i = 0; i <= CHANNEL_MAX; i++) {
+                band[i] = 5 + i % 3;
+            }
+            uint8_t other = (pilot + (CHANNEL_MAX+1) / 2) % (CHANNEL_MAX+1);
+            switch(environment) {
+                case 0:
+                    band[pilot] = 90;
+                    break;
+                case 1:
+                    band[pilot] = 45;
+                    break;
+                case 2: // the neighbours in frequency get some of it
+                    band[pilot] = 85;
+                    band[pilot > CHANNEL_MIN ? pilot-1 : pilot+2] = 60;
+                    band[pilot < CHANNEL_MAX ? pilot+1 : pilot-2] = 60;
+                    break;
+                case 3:
+                    band[pilot] = 90;
+                    band[other] = 70;
+                    break;
+            }
+            for(uint8_t guided = 0; guided < 2; guided++) {
+                uint8_t locked;
+                sum[guided] += seekTime(band, CHANNEL_MIN, guided, &locked);
+                CHECK_EQUAL(pilot, locked);
+            }
+        }
+        for(uint8_t guided = 0; guided < 2; guided++) {
+            mean[environment][guided] = sum[guided] / (CHANNEL_MAX+1);
+        }
+        printf("seek %-12s linear %5lu ms, guided %5lu ms\n", names[environment], mean[environment][0], mean[environment][1]);
+    }
+    // a second pass of the linear seek is slower than the sweep
+    CHECK(mean[1][1] < mean[1][0]);
+}
+
+// UP and DOWN restart the guided seek at the nearest candidate above or
+// below, the linear seek steps that way around the band.
+static void testSeekDirection() {
+    uint8_t band[CHANNEL_MAX+1];
+    memset(band, 5, sizeof(band));
+    band[5] = 60;
+    band[20] = 90;
+    band[30] = 70;
+    band[35] = 65;
+    uint8_t locked;
+    seek_direction = 1;
+    seekTime(band, CHANNEL_MIN, true, &locked);
+    CHECK_EQUAL(20, locked);
+    CHECK_EQUAL(1, seek_candidate);
+
+    force_seek = 1;
+    seek_direction = -1;
+    CHECK_EQUAL(5, seekGuided(20, 90));
+    force_seek = 1;
+    seek_direction = 1;
+    CHECK_EQUAL(30, seekGuided(5, 60));
+    force_seek = 1;
+    CHECK_EQUAL(35, seekGuided(30, 70));
+    force_seek = 1;
+    CHECK_EQUAL(SEEK_SWEEP, seekGuided(35, 65)); // all checked, sweep again
+
+    seek_direction = -1;
+    force_seek = 1;
+    CHECK_EQUAL(CHANNEL_MAX, seekLinear(CHANNEL_MIN, 5));
+    CHECK_EQUAL(CHANNEL_MAX-1, seekLinear(CHANNEL_MAX, 5));
+    seek_direction = 1;
+    CHECK_EQUAL(CHANNEL_MIN, seekLinear(CHANNEL_MAX, 5));
+}
+
+int main() {
+    testAverage();
+    testDecimation();
+    testScale();
+    testCutover();
+    testSeekThreshold();
+    testSeekRank();
+    testFilterNetwork();
+    testFilterSpikes();
+    testFilterReads();
+    testSettled();
+    testTwoPassScan();
+    testSeekTime();
+    testSeekDirection();
+    return testResult(TEST_NAME);
+}
@@ -0,0 +1,94 @@
+// Scout receiver B sweeping the band against simulated transmitters.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "channels.h"
+#include "scout.h"
+#include "test.h"
+
+// main project
+uint16_t rssi_min_b = 100;
+uint16_t rssi_max_b = 400;
+static uint8_t tuned_b;
+void setChannelModule(uint8_t channel, uint8_t select_pin) {
+    if(select_pin == slaveSelectPinB) {
+        tuned_b = channel;
+    }
+}
+
+// transmitters on the air, a receiver sees them up to 8 MHz off
+#define TRANSMITTERS 4
+static uint16_t on_air[TRANSMITTERS];
+
+static uint16_t receiverB(uint8_t pin) {
+    if(pin != rssiPinB) {
+        return 0;
+    }
+    uint16_t frequency = pgm_read_word_near(channelFreqTable + tuned_b);
+    for(uint8_t i = 0; i < TRANSMITTERS; i++) {
+        if(on_air[i] && abs((int)frequency - on_air[i]) <= 8) {
+            return rssi_max_b;
+        }
+    }
+    return rssi_min_b;
+}
+
+// events of one sweep
+static uint8_t events[3];
+static uint16_t event_frequency;
+
+static void sweep(uint8_t watched_index) {
+    memset(events, 0, sizeof(events));
+    for(uint8_t i = CHANNEL_MIN; i <= CHANNEL_MAX; i++) {
+        stub_micros += MIN_TUNE_TIME * 1000UL;
+        CHECK(scoutUpdate(watched_index));
+        events[scout_event]++;
+        if(scout_event != SCOUT_NONE) {
+            event_frequency = pgm_read_word_near(channelFreqTable + pgm_read_byte_near(channelList + scout_position));
+        }
+    }
+}
+
+static void testWatched(uint8_t watched_index) {
+    uint16_t watched = pgm_read_word_near(channelFreqTable + watched_index);
+    memset(on_air, 0, sizeof(on_air));
+    scoutStop();
+    scoutStart();
+    sweep(watched_index);
+    sweep(watched_index);
+    CHECK_EQUAL(0, events[SCOUT_NEW] + events[SCOUT_INTERFERENCE]);
+
+    // the watched pilot powers up, it shows on every channel of its
+    // frequency and next to it
+    on_air[0] = watched;
+    sweep(watched_index);
+    CHECK_EQUAL(0, events[SCOUT_NEW] + events[SCOUT_INTERFERENCE]);
+    sweep(watched_index);
+    CHECK_EQUAL(0, events[SCOUT_NEW] + events[SCOUT_INTERFERENCE]);
+
+    // a second pilot close by
+    on_air[1] = watched - 20;
+    sweep(watched_index);
+    CHECK(events[SCOUT_INTERFERENCE] > 0);
+    CHECK_EQUAL(0, events[SCOUT_NEW]);
+    CHECK(abs((int)event_frequency - on_air[1]) <= 8);
+    sweep(watched_index);
+    CHECK_EQUAL(0, events[SCOUT_NEW] + events[SCOUT_INTERFERENCE]);
+
+    // and one far away
+    on_air[2] = watched > 5800 ? 5658 : 5917;
+    sweep(watched_index);
+    CHECK(events[SCOUT_NEW] > 0);
+    CHECK_EQUAL(0, events[SCOUT_INTERFERENCE]);
+    CHECK(abs((int)event_frequency - on_air[2]) <= 8);
+}
+
+int main() {
+    stubReset();
+    stub_analog_source = receiverB;
+    testWatched(31); // F8 5880, the same as R7
+    testWatched(7); // A8 5725, B1 is 5733 and R3 5732
+    testWatched(38); // R7
+    testWatched(0); // A1 5865, B8 is 5866
+    return testResult(TEST_NAME);
+}
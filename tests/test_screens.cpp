@@ -0,0 +1,109 @@
+// The same screen workload on every screens backend. Built once per
+// display option, the AUTO_SCREENS build runs it on both displays through
+// the forwarding class.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "screens.h"
+#include "widgets.h"
+#include "test.h"
+
+// ten characters like the one read from the EEPROM
+static char call_sign[11] = "TEST      ";
+
+// every screen with a few updates, returns the widget draws. They are only
+// counted with USE_INSTRUMENTS, 1 without.
+static uint16_t workload(screens &drawScreen) {
+#ifdef USE_INSTRUMENTS
+    uint16_t draws = widget_draws;
+#endif
+    drawScreen.flip();
+    drawScreen.flip();
+    for(uint8_t menu = 0; menu < 5; menu++) {
+        drawScreen.mainMenu(menu);
+    }
+
+    drawScreen.seekMode(STATE_SEEK);
+    for(uint8_t channel = 0; channel <= CHANNEL_MAX_INDEX; channel++) {
+        drawScreen.updateSeekMode(STATE_SEEK, channel, channel, channel*2, 5645 + channel*8, 50, channel & 1);
+#ifdef USE_SCOUT
+        drawScreen.updateScout((channel + 5) % (CHANNEL_MAX_INDEX+1), 70);
+#endif
+    }
+    drawScreen.seekMode(STATE_MANUAL);
+    drawScreen.updateSeekMode(STATE_MANUAL, 12, 20, 80, 5880, 50, false);
+    drawScreen.updateSeekMode(STATE_MANUAL, 12, 20, 82, 5880, 50, false);
+
+    for(uint8_t state = STATE_SCAN; state <= STATE_RSSI_SETUP; state += STATE_RSSI_SETUP - STATE_SCAN) {
+        drawScreen.bandScanMode(state);
+        for(uint8_t channel = 0; channel <= CHANNEL_MAX_INDEX; channel++) {
+            drawScreen.updateBandScanMode(state == STATE_RSSI_SETUP, channel, 100 - channel, 0xA1 + channel % 8, 5645 + channel*8, 90, 250);
+        }
+    }
+
+    drawScreen.screenSaver(0xA1, 5865, call_sign);
+    drawScreen.updateScreenSaver(40);
+    drawScreen.updateScreenSaver(60);
+#ifdef USE_DIVERSITY
+    drawScreen.screenSaver(useReceiverAuto, 0xA1, 5865, call_sign);
+    drawScreen.updateScreenSaver(useReceiverA, 70, 70, 30);
+    drawScreen.updateScreenSaver(useReceiverB, 80, 20, 80);
+
+    for(uint8_t mode = useReceiverAuto; mode <= useReceiverB; mode++) {
+        drawScreen.diversity(mode);
+        drawScreen.updateDiversity(useReceiverA, 90, 10);
+        drawScreen.updateDiversity(useReceiverB, 10, 90);
+    }
+#endif
+#ifdef USE_VOLTAGE_MONITORING
+    drawScreen.updateVoltageScreenSaver(118, false);
+    drawScreen.updateVoltageScreenSaver(98, true);
+    drawScreen.voltage(0, 0, 110, 100);
+    drawScreen.updateVoltage(121);
+    drawScreen.voltage(3, 5, 110, 100);
+    drawScreen.updateVoltage(99);
+#endif
+
+    drawScreen.setupMenu();
+    drawScreen.updateSetupMenu(0, true, false, call_sign, -1);
+    drawScreen.updateSetupMenu(3, false, true, call_sign, 2);
+
+    drawScreen.save(STATE_SEEK, 27, 5880, call_sign);
+    drawScreen.updateSave("SAVED");
+#ifdef USE_INSTRUMENTS
+    drawScreen.instruments();
+    drawScreen.updateInstruments(1000, 4000, 2, 300, 350, 30000, 9000, 3400);
+    drawScreen.updateInstruments(1200, 3900, 0, 300, 340, 30000, 8000, 0);
+#endif
+#ifdef USE_INSTRUMENTS
+    return widget_draws - draws;
+#else
+    return 1;
+#endif
+}
+
+int main() {
+    stubReset();
+    static screens drawScreen;
+#ifdef AUTO_SCREENS
+    // no pull ups on the I2C pins, TV out
+    stub_pins[SDA] = LOW;
+    CHECK_EQUAL(0, drawScreen.begin(call_sign));
+    CHECK_EQUAL(DISPLAY_TVOUT, screens_display);
+    size_t transmissions = stub_wire.size();
+    CHECK(workload(drawScreen) > 0);
+    CHECK_EQUAL(transmissions, stub_wire.size());
+
+    // the OLED answers on the bus
+    stub_pins[SDA] = HIGH;
+    CHECK_EQUAL(0, drawScreen.begin(call_sign));
+    CHECK_EQUAL(DISPLAY_OLED_SSD1306, screens_display);
+    transmissions = stub_wire.size();
+    CHECK(workload(drawScreen) > 0);
+    CHECK(stub_wire.size() > transmissions);
+#else
+    CHECK_EQUAL(0, drawScreen.begin(call_sign));
+    CHECK(workload(drawScreen) > 0);
+#endif
+    return testResult(TEST_NAME);
+}
@@ -0,0 +1,139 @@
+// I2C byte stream of the SSD1306 screens into a simulated controller. Built
+// for the SSD1306 and the SH1106, which has 132 columns and shows 2 to 129.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "screens.h"
+#include "widgets.h"
+#include "test.h"
+
+#ifdef SH1106
+    #define COLUMNS 132
+    #define OFFSET 2
+#else
+    #define COLUMNS 128
+    #define OFFSET 0
+#endif
+
+// controller in page addressing mode
+struct controller {
+    uint8_t ram[8][COLUMNS];
+    uint8_t page;
+    uint8_t column;
+    int data_bytes; // written to the ram
+    int written[COLUMNS]; // writes per column
+};
+
+static controller oled;
+
+// feeds the transmissions since the last call to the controller.
+static size_t sent = 0;
+static void receive() {
+    for(; sent < stub_wire.size(); sent++) {
+        std::vector<uint8_t> &bytes = stub_wire[sent];
+        CHECK_EQUAL(0x3C, bytes[0]);
+        CHECK(bytes.size() <= 32); // Wire buffer
+        if(bytes.size() < 2) {
+            continue;
+        }
+        if(bytes[1] == 0x40) {
+            for(size_t i = 2; i < bytes.size(); i++) {
+                CHECK(oled.column < COLUMNS);
+                if(oled.column < COLUMNS) {
+                    oled.ram[oled.page][oled.column] = bytes[i];
+                    oled.written[oled.column]++;
+                    oled.column++;
+                    oled.data_bytes++;
+                }
+            }
+            continue;
+        }
+        CHECK_EQUAL(0x00, bytes[1]);
+        for(size_t i = 2; i < bytes.size(); i++) {
+            uint8_t command = bytes[i];
+            if((command & 0xF0) == 0xB0) {
+                oled.page = command & 0x07;
+            }
+            else if((command & 0xF0) == 0x00) {
+                oled.column = (oled.column & 0xF0) | command;
+            }
+            else if((command & 0xF0) == 0x10) {
+                oled.column = (oled.column & 0x0F) | ((command & 0x0F) << 4);
+            }
+        }
+    }
+}
+
+static screens drawScreen;
+
+static void update(uint8_t channelIndex, uint8_t rssi) {
+    drawScreen.updateSeekMode(STATE_MANUAL, channelIndex, 3, rssi, 5645 + channelIndex*5, 50, false);
+    receive();
+}
+
+static void testColumns() {
+    drawScreen.seekMode(STATE_MANUAL);
+    update(0, 50);
+    receive();
+    size_t transmissions = stub_wire.size();
+    oled.data_bytes = 0;
+
+    // no change, nothing on the bus
+    update(0, 50);
+    CHECK_EQUAL(transmissions, stub_wire.size());
+
+    // the rssi bar grows from 62 to 64 pixels: page 4, columns 63 and 64
+    update(0, 52);
+    CHECK_EQUAL(transmissions + 2, stub_wire.size());
+    if(stub_wire.size() == transmissions + 2) {
+        const uint8_t address[] = { 0x3C, 0x00, 0xB4, (63+OFFSET) & 0x0F, 0x10 | ((63+OFFSET) >> 4) };
+        CHECK(stub_wire[transmissions] == std::vector<uint8_t>(address, address + sizeof(address)));
+        CHECK_EQUAL(4, stub_wire[transmissions + 1].size());
+    }
+    CHECK_EQUAL(2, oled.data_bytes);
+    // rows 33 to 35 between the lines on row 32 and 36
+    CHECK_EQUAL(0x1F, oled.ram[4][63+OFFSET]);
+    CHECK_EQUAL(0x1F, oled.ram[4][64+OFFSET]);
+    CHECK_EQUAL(0x11, oled.ram[4][65+OFFSET]);
+
+    // full width, the columns go out in 16 byte pieces
+    oled.data_bytes = 0;
+    transmissions = stub_wire.size();
+    widgetInvalidate(0, 40, 128, 1);
+    update(0, 52);
+    CHECK_EQUAL(128, oled.data_bytes);
+    CHECK_EQUAL(1 + 8, stub_wire.size() - transmissions);
+}
+
+// the same picture however it was reached
+static void testIncremental() {
+    static uint8_t updated[8][COLUMNS];
+    drawScreen.seekMode(STATE_MANUAL);
+    for(uint8_t i = 0; i < 40; i++) {
+        update(i % 32, (i * 37) % 100);
+    }
+    update(13, 64);
+    memcpy(updated, oled.ram, sizeof(updated));
+
+    memset(oled.ram, 0xAA, sizeof(oled.ram));
+    drawScreen.seekMode(STATE_MANUAL);
+    update(13, 64);
+    for(uint8_t page = 0; page < 8; page++) {
+        CHECK(memcmp(updated[page] + OFFSET, oled.ram[page] + OFFSET, 128) == 0);
+    }
+}
+
+int main() {
+    stubReset();
+    memset(&oled, 0, sizeof(oled));
+    CHECK_EQUAL(0, drawScreen.begin("TEST      "));
+    receive();
+    // every visible column was written, the SH1106 border never
+    for(uint8_t column = 0; column < COLUMNS; column++) {
+        bool visible = column >= OFFSET && column < OFFSET + 128;
+        CHECK_EQUAL(visible, oled.written[column] > 0);
+    }
+    testColumns();
+    testIncremental();
+    return testResult(TEST_NAME);
+}
@@ -0,0 +1,64 @@
+// u8glib picture loop of the u8g screens, only dirty pages are drawn and
+// sent to the controller.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "screens.h"
+#include "test.h"
+
+extern uint16_t u8g_page_renders;
+extern uint16_t u8g_page_skips;
+
+static screens drawScreen;
+
+static void update(uint8_t rssi) {
+    stub_u8g_pages.clear();
+    u8g_page_renders = 0;
+    u8g_page_skips = 0;
+    drawScreen.updateSeekMode(STATE_MANUAL, 0, 0, rssi, 5865, 50, false);
+}
+
+static void testPageSkip(uint8_t rssi_page) {
+    stub_u8g_pages.clear();
+    u8g_page_renders = 0;
+    drawScreen.seekMode(STATE_MANUAL);
+    CHECK_EQUAL(8, u8g_page_renders);
+    CHECK_EQUAL(8, stub_u8g_pages.size());
+
+    // band, frequency, rssi bar and spectrum, the channel list was drawn
+    // with the screen and the title row and frequency scale stay
+    update(50);
+    CHECK_EQUAL(5, u8g_page_renders);
+    CHECK_EQUAL(3, u8g_page_skips);
+    CHECK_EQUAL(5, stub_u8g_pages.size());
+
+    // nothing changed, no picture loop at all
+    update(50);
+    CHECK_EQUAL(0, u8g_page_renders);
+    CHECK_EQUAL(0, u8g_page_skips);
+    CHECK_EQUAL(0, stub_u8g_pages.size());
+
+    // the rssi bar grows, the spectrum bar stays the same height
+    update(52);
+    CHECK_EQUAL(1, u8g_page_renders);
+    CHECK_EQUAL(7, u8g_page_skips);
+    CHECK_EQUAL(1, stub_u8g_pages.size());
+    if(stub_u8g_pages.size() == 1) {
+        CHECK_EQUAL(rssi_page, stub_u8g_pages[0]);
+    }
+
+    // the spectrum bar of the channel grows as well
+    update(90);
+    CHECK_EQUAL(3, u8g_page_renders);
+    CHECK_EQUAL(5, u8g_page_skips);
+}
+
+int main() {
+    stubReset();
+    drawScreen.begin("TEST");
+    // rows 32 to 39 are the controller page 4, page 3 when rotated
+    testPageSkip(4);
+    drawScreen.flip();
+    testPageSkip(3);
+    return testResult("u8g");
+}
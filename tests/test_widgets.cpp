@@ -0,0 +1,135 @@
+// Retained widgets drawn into a 128x64 frame buffer by test hooks.
+
+#include <Arduino.h>
+#include "settings.h"
+#include "widgets.h"
+#include "test.h"
+
+static uint8_t screen[64][128];
+static int fills;
+
+static void fill(int x, int y, int w, int h, uint8_t color) {
+    for(int row = y; row < y+h && row < 64; row++) {
+        for(int col = x; col < x+w && col < 128; col++) {
+            screen[row][col] = color;
+        }
+    }
+}
+
+template<> void widgetHooks<SCREENS_DISPLAY>::fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    fills++;
+    fill(x, y, w, h, color);
+}
+
+template<> void widgetHooks<SCREENS_DISPLAY>::drawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color) {
+    fill(x, y, w, 1, color);
+    fill(x, y+h-1, w, 1, color);
+    fill(x, y, 1, h, color);
+    fill(x+w-1, y, 1, h, color);
+}
+
+template<> void widgetHooks<SCREENS_DISPLAY>::text(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const char *text, uint8_t style) {
+    fill(x, y, w, h, (style & WIDGET_INVERT) ? WIDGET_WHITE : WIDGET_BLACK);
+}
+
+template<> void widgetHooks<SCREENS_DISPLAY>::invalidate(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+}
+
+// white pixels in row y from x0 to x1
+static int whiteRun(int y, int x0, int x1) {
+    int count = 0;
+    for(int x = x0; x <= x1; x++) {
+        count += screen[y][x];
+    }
+    return count;
+}
+
+static void testBar() {
+    memset(screen, 0, sizeof(screen));
+    widgetsReset();
+    widget &bar = widgets[0];
+    bar.bar(10, 20, 100, 5, 0);
+
+    CHECK(bar.update(30));
+    CHECK_EQUAL(30, whiteRun(22, 0, 127));
+    CHECK(!bar.update(30));
+
+    // growing and shrinking only fills the difference
+    fills = 0;
+    CHECK(bar.update(50));
+    CHECK_EQUAL(1, fills);
+    CHECK_EQUAL(50, whiteRun(22, 0, 127));
+    fills = 0;
+    CHECK(bar.update(20));
+    CHECK_EQUAL(1, fills);
+    CHECK_EQUAL(20, whiteRun(22, 0, 127));
+    CHECK_EQUAL(0, whiteRun(22, 30, 127));
+}
+
+static void testOutlineBar() {
+    memset(screen, 0, sizeof(screen));
+    widgetsReset();
+    widget &bar = widgets[1];
+    bar.bar(10, 20, 100, 5, 0);
+
+    CHECK(bar.update(20, WIDGET_OUTLINE));
+    CHECK_EQUAL(20, whiteRun(20, 0, 127)); // top edge
+    CHECK_EQUAL(2, whiteRun(22, 0, 127)); // left and right edge
+
+    // an inactive receiver stays a frame when its value changes
+    CHECK(bar.update(40, WIDGET_OUTLINE));
+    CHECK_EQUAL(40, whiteRun(20, 0, 127));
+    CHECK_EQUAL(2, whiteRun(22, 0, 127));
+    CHECK_EQUAL(1, screen[22][49]);
+    CHECK_EQUAL(0, screen[22][29]);
+
+    CHECK(bar.update(15, WIDGET_OUTLINE));
+    CHECK_EQUAL(15, whiteRun(24, 0, 127)); // bottom edge
+    CHECK_EQUAL(2, whiteRun(22, 0, 127));
+    CHECK_EQUAL(1, screen[22][24]);
+    CHECK_EQUAL(0, whiteRun(20, 25, 127));
+
+    // active again, filled
+    CHECK(bar.update(15));
+    CHECK_EQUAL(15, whiteRun(22, 0, 127));
+    CHECK(bar.update(10, WIDGET_OUTLINE));
+    CHECK_EQUAL(2, whiteRun(22, 0, 127));
+}
+
+static void testVerticalOutlineBar() {
+    memset(screen, 0, sizeof(screen));
+    widgetsReset();
+    widget &bar = widgets[2];
+    bar.bar(10, 10, 4, 40, WIDGET_VERTICAL);
+
+    CHECK(bar.update(10, WIDGET_OUTLINE));
+    CHECK(bar.update(30, WIDGET_OUTLINE));
+    // frame from row 20 to 49, empty inside
+    CHECK_EQUAL(4, whiteRun(20, 10, 13));
+    CHECK_EQUAL(2, whiteRun(30, 10, 13));
+    CHECK_EQUAL(2, whiteRun(40, 10, 13));
+    CHECK_EQUAL(4, whiteRun(49, 10, 13));
+    CHECK_EQUAL(0, whiteRun(19, 10, 13));
+}
+
+static void testMarker() {
+    memset(screen, 0, sizeof(screen));
+    widgetsReset();
+    widget &marker = widgets[3];
+    marker.marker(0, 5, 2, 3, 0);
+
+    CHECK(marker.update(10));
+    CHECK_EQUAL(2, whiteRun(6, 0, 127));
+    CHECK(marker.update(40));
+    CHECK_EQUAL(2, whiteRun(6, 0, 127));
+    CHECK_EQUAL(1, screen[6][41]);
+}
+
+int main() {
+    stubReset();
+    testBar();
+    testOutlineBar();
+    testVerticalOutlineBar();
+    testMarker();
+    return testResult("widgets");
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Compares two benchmark reports of rx5808-pro-diversity.
+
+Build with USE_BENCHMARK, log the serial output at 9600 baud after a reset
+and compare the logs of two builds:
+
+    bench_compare.py before.log after.log
+
+The last report of each log is used. Exits with 1 if the mean of any
+benchmark got slower by more than the threshold.
+"""
+
+import argparse
+import sys
+
+
+def parse(path):
+    """Returns (timer, results) of the last complete report in the log."""
+    report = None
+    last = None
+    with open(path, errors="replace") as log:
+        for line in log:
+            fields = line.split()
+            if not fields:
+                continue
+            if fields[0] == "BENCH_BEGIN" and len(fields) >= 2:
+                report = (fields[1], {})
+            elif fields[0] == "BENCH_END" and report:
+                last = report
+                report = None
+            elif fields[0] == "BENCH" and report and len(fields) == 6:
+                name = fields[1]
+                runs, least, mean, most = (int(value) for value in fields[2:])
+                report[1][name] = {"runs": runs, "min": least, "mean": mean, "max": most}
+    if last is None:
+        sys.exit("%s: no complete benchmark report" % path)
+    return last
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("before")
+    parser.add_argument("after")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="percent the mean may grow before it counts as a regression (default 5)")
+    args = parser.parse_args()
+
+    before_timer, before = parse(args.before)
+    after_timer, after = parse(args.after)
+    if before_timer != after_timer:
+        print("warning: timers differ (%s and %s), the numbers are not comparable"
+              % (before_timer, after_timer), file=sys.stderr)
+
+    regressions = []
+    print("%-18s %10s %10s %8s %10s %10s" % ("benchmark", "before", "after", "change", "min", "max"))
+    for name in list(before) + [name for name in after if name not in before]:
+        if name not in before or name not in after:
+            print("%-18s %s" % (name, "only after" if name in after else "only before"))
+            continue
+        old = before[name]["mean"]
+        new = after[name]
+        change = (new["mean"] - old) * 100.0 / old if old else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  SLOWER"
+            regressions.append(name)
+        elif change < -args.threshold:
+            mark = "  faster"
+        print("%-18s %10d %10d %+7.1f%% %10d %10d%s" % (name, old, new["mean"], change, new["min"], new["max"], mark))
+
+    if regressions:
+        print("\n%d regression(s) above %.1f%%: %s" % (len(regressions), args.threshold, ", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
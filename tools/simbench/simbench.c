@@ -0,0 +1,185 @@
+/*
+ * Simulator benchmark harness for rx5808-pro-diversity.
+ *
+ * Runs a USE_SIMBENCH build on simavr. The firmware writes a scenario id
+ * to GPIOR0 when a scenario starts and 0 when it ends, GPIOR1 holds the
+ * result. The harness feeds the rssi inputs for each scenario, counts the
+ * cycles between the marks and the lowest stack pointer, then prints
+ *
+ *     SIM <scenario> cycles=<n> stack=<bytes> free=<bytes> result=<n>
+ *
+ * Usually built and run by simbench.py.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+#include <simavr/avr_adc.h>
+#include <simavr/avr_ioport.h>
+
+/* scenario ids, keep src/rx5808-pro-diversity/simbench.h in sync */
+#define SIMBENCH_SWEEP 1
+#define SIMBENCH_SEEK 2
+#define SIMBENCH_SCREENSAVER 3
+#define SIMBENCH_DIVERSITY 4
+#define SIMBENCH_DONE 0xFF
+
+#define GPIOR0_ADDR 0x3E
+#define GPIOR1_ADDR 0x4A
+#define RSSI_A_ADC 6 /* rssiPinA A6 */
+#define RSSI_B_ADC 7 /* rssiPinB A7 */
+
+/* rssi levels in mV, RSSI_MIN_VAL 90 and RSSI_MAX_VAL 220 are about 440 and 1075 mV */
+#define RSSI_WEAK 450
+#define RSSI_STRONG 1000
+#define SEEK_LOCK_AFTER 400 /* conversions before the seek finds a signal */
+#define DIVERSITY_SWAP 64   /* conversions before the strong receiver changes */
+
+static const char *names[] = { "boot", "sweep", "seek", "screensaver", "diversity" };
+
+static avr_t *avr;
+static uint8_t scenario;
+static uint8_t result;
+static avr_cycle_count_t start;
+static uint16_t lowest_sp;
+static uint16_t heap_start, brkval;
+static uint32_t conversions;
+static int done;
+
+static uint16_t stackPointer(void) {
+    return avr->data[R_SPL] | (avr->data[R_SPH] << 8);
+}
+
+/* end of the heap, __brkval is 0 until the first malloc() */
+static uint16_t heapTop(void) {
+    uint16_t top = brkval ? avr->data[brkval] | (avr->data[brkval+1] << 8) : 0;
+    return top ? top : heap_start;
+}
+
+static void report(void) {
+    const char *name = scenario < sizeof(names)/sizeof(names[0]) ? names[scenario] : "unknown";
+    int free_ram = heap_start ? (int)lowest_sp - heapTop() : -1;
+    printf("SIM %s cycles=%llu stack=%u free=%d result=%u\n", name,
+        (unsigned long long)(avr->cycle - start), avr->ramend - lowest_sp, free_ram, result);
+}
+
+static void gpior0Write(avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param) {
+    avr->data[addr] = v;
+    if(v == SIMBENCH_DONE) {
+        done = 1;
+    } else if(v) {
+        if(scenario == 0) {
+            report(); /* setup up to the first scenario */
+        }
+        scenario = v;
+    } else {
+        report();
+    }
+    start = avr->cycle;
+    lowest_sp = stackPointer();
+    conversions = 0;
+}
+
+static void gpior1Write(avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param) {
+    avr->data[addr] = v;
+    result = v;
+}
+
+static uint32_t rssiLevel(uint8_t receiver) {
+    switch(scenario) {
+        case SIMBENCH_SEEK:
+            return conversions > SEEK_LOCK_AFTER ? RSSI_STRONG : RSSI_WEAK;
+        case SIMBENCH_DIVERSITY:
+            return (conversions / DIVERSITY_SWAP & 1) == (receiver == RSSI_B_ADC) ? RSSI_STRONG : RSSI_WEAK;
+        default:
+            return RSSI_WEAK;
+    }
+}
+
+static void adcTrigger(struct avr_irq_t *irq, uint32_t value, void *param) {
+    union {
+        avr_adc_mux_t mux;
+        uint32_t v;
+    } e = { .v = value };
+    uint8_t channel = e.mux.src;
+    uint32_t mv = 0;
+    if(channel == RSSI_A_ADC || channel == RSSI_B_ADC) {
+        conversions++;
+        mv = rssiLevel(channel);
+    }
+    avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_ADC0 + channel), mv);
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [--heap-start addr] [--brkval addr] [--max-cycles n] firmware.elf\n", name);
+    exit(2);
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = NULL;
+    unsigned long long max_cycles = 2000000000ULL;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--heap-start") && i+1 < argc) {
+            heap_start = strtoul(argv[++i], NULL, 0);
+        } else if(!strcmp(argv[i], "--brkval") && i+1 < argc) {
+            brkval = strtoul(argv[++i], NULL, 0);
+        } else if(!strcmp(argv[i], "--max-cycles") && i+1 < argc) {
+            max_cycles = strtoull(argv[++i], NULL, 0);
+        } else if(argv[i][0] == '-' || path) {
+            usage(argv[0]);
+        } else {
+            path = argv[i];
+        }
+    }
+    if(!path) {
+        usage(argv[0]);
+    }
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+    if(elf_read_firmware(path, &firmware)) {
+        fprintf(stderr, "%s: can not read firmware\n", path);
+        return 2;
+    }
+    avr = avr_make_mcu_by_name(firmware.mmcu[0] ? firmware.mmcu : "atmega328p");
+    if(!avr) {
+        fprintf(stderr, "%s: unknown mcu\n", path);
+        return 2;
+    }
+    avr_init(avr);
+    avr->frequency = firmware.frequency ? firmware.frequency : 16000000;
+    avr->avcc = avr->aref = avr->vcc = 5000;
+    avr->log = LOG_WARNING;
+    avr_load_firmware(avr, &firmware);
+
+    avr_register_io_write(avr, GPIOR0_ADDR, gpior0Write, NULL);
+    avr_register_io_write(avr, GPIOR1_ADDR, gpior1Write, NULL);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_OUT_TRIGGER), adcTrigger, NULL);
+    /* buttons on D2 to D5 are active low, none is pressed */
+    for(int pin = 2; pin <= 5; pin++) {
+        avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), pin), 1);
+    }
+
+    lowest_sp = avr->ramend;
+    int state = cpu_Running;
+    while(!done && state != cpu_Done && state != cpu_Crashed) {
+        state = avr_run(avr);
+        uint16_t sp = stackPointer();
+        if(sp && sp < lowest_sp) {
+            lowest_sp = sp;
+        }
+        if(avr->cycle > max_cycles) {
+            fprintf(stderr, "gave up after %llu cycles in %s\n", max_cycles,
+                scenario < sizeof(names)/sizeof(names[0]) ? names[scenario] : "unknown");
+            return 1;
+        }
+    }
+    if(!done) {
+        fprintf(stderr, "firmware stopped before the end of the scenarios\n");
+        return 1;
+    }
+    return 0;
+}
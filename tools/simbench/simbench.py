@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""Cycle counted benchmarks of rx5808-pro-diversity under simavr.
+
+Builds the firmware for the ATmega328P with USE_SIMBENCH, runs the
+scripted scenarios (channel sweep, seek to lock, screen saver frames and
+diversity switching) in simavr and compares the cycles and the stack use
+against baseline.txt:
+
+    simbench.py                 build, run and compare
+    simbench.py --elf fw.elf    use a firmware that is already built
+    simbench.py --update        write the results as the new baseline
+
+The baseline is only comparable with the toolchain it was made with, its
+header records the versions. Run from the repository root:
+
+    tools/simbench/simbench.py --update
+    git add tools/simbench/baseline.txt
+
+Needs arduino-cli with the arduino:avr core, avr-nm, a C compiler and
+simavr with its headers. Exits with 1 if a scenario got slower or used
+more stack than the threshold allows.
+"""
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(HERE))
+SKETCH = os.path.join(REPO, "src", "rx5808-pro-diversity")
+LIBRARIES = os.path.join(REPO, "src", "libraries")
+BASELINE = os.path.join(HERE, "baseline.txt")
+FQBN = "arduino:avr:nano:cpu=atmega328"
+
+
+def run(command, **kwargs):
+    try:
+        return subprocess.run(command, check=True, universal_newlines=True, **kwargs)
+    except FileNotFoundError:
+        sys.exit("%s not found" % command[0])
+    except subprocess.CalledProcessError as error:
+        sys.exit("%s failed with %d" % (command[0], error.returncode))
+
+
+def buildFirmware(out):
+    run(["arduino-cli", "compile", "--fqbn", FQBN, "--libraries", LIBRARIES,
+         "--build-property", "compiler.cpp.extra_flags=-DUSE_SIMBENCH",
+         "--output-dir", out, SKETCH], stdout=subprocess.DEVNULL)
+    return os.path.join(out, "rx5808-pro-diversity.ino.elf")
+
+
+def buildHarness(out):
+    harness = os.path.join(out, "simbench")
+    flags = []
+    if shutil.which("pkg-config"):
+        result = subprocess.run(["pkg-config", "--cflags", "--libs", "simavr"],
+                                stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                                universal_newlines=True)
+        flags = result.stdout.split() if result.returncode == 0 else []
+    if not flags:
+        flags = ["-lsimavr", "-lelf"]
+    cc = os.environ.get("CC", "cc")
+    run([cc, "-O2", "-std=gnu99", "-o", harness, os.path.join(HERE, "simbench.c")] + flags)
+    return harness
+
+
+def symbols(elf):
+    """Data addresses of the heap start and __brkval."""
+    result = run(["avr-nm", elf], stdout=subprocess.PIPE)
+    found = {}
+    for line in result.stdout.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[2] in ("__heap_start", "__brkval"):
+            # data addresses are offset by 0x800000 in the elf
+            found[fields[2]] = int(fields[0], 16) & 0xFFFF
+    return found
+
+
+def version(command):
+    """First line of the version output, or "-" if the tool is missing."""
+    try:
+        result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                universal_newlines=True)
+    except FileNotFoundError:
+        return "-"
+    lines = result.stdout.strip().splitlines()
+    return lines[0].strip() if result.returncode == 0 and lines else "-"
+
+
+def header():
+    """Comment lines of a new baseline, parse() skips them."""
+    return [
+        "# tools/simbench/simbench.py --update",
+        "# arduino-cli: %s" % version(["arduino-cli", "version"]),
+        "# avr-gcc: %s" % version(["avr-gcc", "--version"]),
+        "# simavr: %s" % version(["pkg-config", "--modversion", "simavr"]),
+    ]
+
+
+def toolchain(lines):
+    """Tool versions from the header of a baseline."""
+    tools = {}
+    for line in lines:
+        if line.startswith("# ") and ": " in line:
+            tool, value = line[2:].split(": ", 1)
+            tools[tool] = value.strip()
+    return tools
+
+
+def parse(lines):
+    results = {}
+    for line in lines:
+        fields = line.split()
+        if len(fields) < 2 or fields[0] != "SIM":
+            continue
+        values = dict(field.split("=", 1) for field in fields[2:] if "=" in field)
+        results[fields[1]] = {key: int(value) for key, value in values.items()}
+    return results
+
+
+def compare(baseline, results, threshold):
+    regressions = []
+    print("%-12s %12s %12s %8s %6s %6s %6s %6s" % (
+        "scenario", "before", "after", "change", "stack", "before", "free", "result"))
+    for name, after in results.items():
+        before = baseline.get(name)
+        if not before:
+            print("%-12s %12s %12d %8s %6d %6s %6d %6d" % (
+                name, "-", after["cycles"], "new", after["stack"], "-", after["free"], after["result"]))
+            continue
+        change = 100.0 * (after["cycles"] - before["cycles"]) / before["cycles"] if before["cycles"] else 0.0
+        print("%-12s %12d %12d %+7.1f%% %6d %6d %6d %6d" % (
+            name, before["cycles"], after["cycles"], change, after["stack"], before["stack"], after["free"], after["result"]))
+        if change > threshold:
+            regressions.append("%s: %+.1f%% cycles" % (name, change))
+        if after["stack"] > before["stack"]:
+            regressions.append("%s: stack grew by %d bytes" % (name, after["stack"] - before["stack"]))
+        if after["result"] != before["result"]:
+            print("warning: %s result changed from %d to %d" % (name, before["result"], after["result"]), file=sys.stderr)
+    for name in baseline:
+        if name not in results:
+            regressions.append("%s: missing" % name)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--elf", help="firmware built with USE_SIMBENCH, skips the build")
+    parser.add_argument("--baseline", default=BASELINE)
+    parser.add_argument("--threshold", type=float, default=2.0,
+                        help="percent the cycles may grow before it counts as a regression (default 2)")
+    parser.add_argument("--update", action="store_true", help="write the results as the new baseline")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as out:
+        elf = args.elf or buildFirmware(out)
+        harness = buildHarness(out)
+        command = [harness]
+        for option, name in (("--heap-start", "__heap_start"), ("--brkval", "__brkval")):
+            address = symbols(elf).get(name)
+            if address:
+                command += [option, hex(address)]
+        result = run(command + [elf], stdout=subprocess.PIPE)
+    lines = [line for line in result.stdout.splitlines() if line.startswith("SIM ")]
+    results = parse(lines)
+    if not results:
+        sys.exit("no results, was the firmware built with USE_SIMBENCH?")
+
+    if args.update:
+        with open(args.baseline, "w") as baseline:
+            baseline.write("\n".join(header() + lines) + "\n")
+        print("\n".join(lines))
+        return 0
+
+    if not os.path.exists(args.baseline):
+        sys.exit("%s: no baseline, run with --update first" % args.baseline)
+    with open(args.baseline) as baseline:
+        lines = baseline.read().splitlines()
+    before = parse(lines)
+    recorded = toolchain(lines)
+    for line in header()[1:]:
+        tool, value = line[2:].split(": ", 1)
+        if tool in recorded and recorded[tool] != value:
+            print("warning: %s is %s, the baseline was made with %s" % (tool, value, recorded[tool]), file=sys.stderr)
+    regressions = compare(before, results, args.threshold)
+    if not before:
+        print("\n%s: no results to compare with, run with --update using the toolchain in its header" % args.baseline)
+        return 1
+    if regressions:
+        print("\nregressions:\n  " + "\n  ".join(regressions))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Decodes event trace dumps of rx5808-pro-diversity into a timeline.
+
+Build the firmware with USE_TRACE, then either log the serial output at
+9600 baud to a file and press UP and DOWN together on the receiver:
+
+    trace_decode.py serial.log
+
+or let the tool ask for a dump itself (needs pyserial):
+
+    trace_decode.py --port /dev/ttyUSB0
+
+Other serial output around the dump is ignored. The format and the event
+types are described in src/rx5808-pro-diversity/trace.h.
+"""
+
+import argparse
+import sys
+
+STATES = {
+    0: "SEEK_FOUND", 1: "SEEK", 2: "SCAN", 3: "MANUAL", 4: "DIVERSITY",
+    5: "SETUP_MENU", 6: "SAVE", 7: "RSSI_SETUP", 8: "SCREEN_SAVER",
+    9: "VOLTAGE", 10: "INSTRUMENTS", 255: "NONE",
+}
+
+TRACE_IDLE = 0x09
+
+
+def state(value):
+    return STATES.get(value, str(value))
+
+
+def channel(name):
+    return "%X%X" % (name >> 4, name & 0x0F)  # 0xA1 is band A channel 1
+
+
+def describe(kind, a, b):
+    if kind == 0x01:
+        return "BOOT", "into %s" % state(a)
+    if kind == 0x02:
+        return "STATE", "%s -> %s" % (state(b), state(a))
+    if kind == 0x03:
+        return "TUNE", "%s on %s" % (channel(a), {1: "A", 2: "B", 3: "A and B"}.get(b, str(b)))
+    if kind in (0x04, 0x05):
+        return "SWITCH", "to %s, rssi A %d%% B %d%%" % ("A" if kind == 0x04 else "B", a, b)
+    if kind == 0x06:
+        return "LOCK", "%s at %d%%" % (channel(a), b)
+    if kind == 0x07:
+        return "FLUSH", "%d in a row, longest %dms" % (a, b)
+    if kind == 0x08:
+        return "STALL", "loop stopped for %dms" % (a | b << 8)
+    if kind == TRACE_IDLE:
+        return "IDLE", "nothing for %d x 65.5s" % (a | b << 8)
+    return "0x%02X" % kind, "%d %d" % (a, b)
+
+
+def parse(lines):
+    """Yields (now, last, events) for every complete dump in lines."""
+    dump = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("TRACE "):
+            fields = line.split()
+            try:
+                dump = (int(fields[1]), int(fields[2]), int(fields[3]), [])
+            except (IndexError, ValueError):
+                dump = None
+        elif dump and line == "END":
+            now, last, count, events = dump
+            if len(events) != count:
+                print("warning: dump at %dms has %d of %d events" % (now, len(events), count), file=sys.stderr)
+            yield now, last, events
+            dump = None
+        elif dump:
+            try:
+                raw = bytes.fromhex(line)
+            except ValueError:
+                raw = b""
+            if len(raw) != 5:
+                print("warning: skipping %r" % line, file=sys.stderr)
+                continue
+            dump[3].append(((raw[0] << 8) | raw[1], raw[2], raw[3], raw[4]))
+
+
+def timeline(last, events):
+    """Absolute ms of every event, the newest one happened at last."""
+    times = [0] * len(events)
+    time = last
+    for i in range(len(events) - 1, -1, -1):
+        times[i] = time
+        if i == 0:
+            break
+        stamp, kind, a, b = events[i]
+        time -= (stamp - events[i - 1][0]) & 0xFFFF
+        if kind == TRACE_IDLE:
+            time -= (a | b << 8) << 16
+    return times
+
+
+def show(now, last, events, out):
+    print("trace dumped at %.3fs, %d events" % (now / 1000.0, len(events)), file=out)
+    previous = None
+    for time, (stamp, kind, a, b) in zip(timeline(last, events), events):
+        name, text = describe(kind, a, b)
+        delta = "" if previous is None else "+%d" % (time - previous)
+        print("%10.3fs %8s  %-7s %s" % (time / 1000.0, delta, name, text), file=out)
+        previous = time
+
+
+def request(port):
+    import serial  # pyserial, only needed to talk to the receiver directly
+    with serial.Serial(port, 9600, timeout=3) as connection:
+        connection.reset_input_buffer()
+        connection.write(b"T")
+        lines = []
+        while True:
+            line = connection.readline().decode("ascii", "replace")
+            if not line:
+                break
+            lines.append(line)
+            if line.strip() == "END":
+                break
+        return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", help="serial log with dumps, stdin if left out")
+    parser.add_argument("--port", help="serial port to request a dump from")
+    args = parser.parse_args()
+
+    if args.port:
+        lines = request(args.port)
+    elif args.log:
+        with open(args.log, errors="replace") as log:
+            lines = log.readlines()
+    else:
+        lines = sys.stdin.readlines()
+
+    dumps = list(parse(lines))
+    if not dumps:
+        print("no trace dump found", file=sys.stderr)
+        return 1
+    for i, dump in enumerate(dumps):
+        if i:
+            print()
+        show(*dump, out=sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())